@@ -0,0 +1,277 @@
+/******************************************************************************
+ * SSD1325Z2 - Library for SSD1325Z2 OLed Driver based on libohiboard
+ * Copyright (C) 2018 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+/*
+ * Benchmark of the driver on host, with the virtual controller as bus.
+ * Every workload runs for a number of frames and prints a CSV line with the
+ * traffic and the time of a single frame, so the output of two versions of
+ * the driver can be compared.
+ *
+ * It needs the GDL sources and the libohiboard headers, for example:
+ *
+ *     cc -O2 -std=gnu99 -D__NO_BOARD_H \
+ *        -DWARCOMEB_SSD1325Z2_WIDTH=128 -DWARCOMEB_SSD1325Z2_HEIGHT=64 \
+ *        -I. -I<libohiboard>/includes -I<path of GDL> \
+ *        bench/ssd1325z2_bench.c ssd1325z2.c ssd1325z2_sim.c <GDL>/gdl.c \
+ *        -o ssd1325z2_bench
+ *
+ * No transport must be selected (WARCOMEB_GDL_PARALLEL, _I2C or _SPI), so
+ * the driver uses the bus operations of the benchmark.
+ */
+
+#include "ssd1325z2.h"
+#include "ssd1325z2_sim.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define SSD1325Z2_BENCH_FRAMES                   200
+
+/**
+ * GPIO writes of the 8080 parallel interface driven pin by pin: every
+ * transfer selects the device, every byte strobes the write pin and writes
+ * eight data pins.
+ */
+#define SSD1325Z2_BENCH_GPIO_TRANSFER            4
+#define SSD1325Z2_BENCH_GPIO_BYTE                10
+
+typedef struct _SSD1325Z2_Bench
+{
+    SSD1325Z2_Sim sim;
+    uint32_t gpioToggles;
+} SSD1325Z2_Bench;
+
+static SSD1325Z2_Bench bench;
+static SSD1325Z2_Device dev;
+
+/*
+ * The bus forwards everything to the simulator and counts GPIO writes.
+ * Commands are sent one by one, like the parallel interface does.
+ */
+static void SSD1325Z2_Bench_writeCommand (void* bus, uint8_t command)
+{
+    SSD1325Z2_Bench* b = (SSD1325Z2_Bench*)bus;
+
+    b->gpioToggles += SSD1325Z2_BENCH_GPIO_TRANSFER + SSD1325Z2_BENCH_GPIO_BYTE;
+    SSD1325Z2_Sim_writeCommand(&b->sim,command);
+}
+
+static void SSD1325Z2_Bench_writeData (void* bus, uint8_t value)
+{
+    SSD1325Z2_Bench* b = (SSD1325Z2_Bench*)bus;
+
+    b->gpioToggles += SSD1325Z2_BENCH_GPIO_TRANSFER + SSD1325Z2_BENCH_GPIO_BYTE;
+    SSD1325Z2_Sim_writeData(&b->sim,value);
+}
+
+static void SSD1325Z2_Bench_writeDataBlock (void* bus, const uint8_t* data, uint16_t length)
+{
+    SSD1325Z2_Bench* b = (SSD1325Z2_Bench*)bus;
+
+    b->gpioToggles += SSD1325Z2_BENCH_GPIO_TRANSFER + SSD1325Z2_BENCH_GPIO_BYTE * length;
+    SSD1325Z2_Sim_writeDataBlock(&b->sim,data,length);
+}
+
+static const SSD1325Z2_BusOps SSD1325Z2_benchBusOps =
+{
+    .writeCommand        = SSD1325Z2_Bench_writeCommand,
+    .writeCommandBlock   = NULL,
+    .writeData           = SSD1325Z2_Bench_writeData,
+    .writeDataBlock      = SSD1325Z2_Bench_writeDataBlock,
+    .writeDataBlockAsync = NULL,
+};
+
+static void SSD1325Z2_Bench_delay (uint32_t delay)
+{
+    (void)delay;
+}
+
+/* Pictures of the splash workloads */
+static uint8_t splash4 [WARCOMEB_SSD1325Z2_BUFFERDIMENSION];
+static uint8_t splash1 [WARCOMEB_SSD1325Z2_WIDTH * WARCOMEB_SSD1325Z2_HEIGHT / 8];
+
+static void SSD1325Z2_Bench_fullFlush (uint32_t frame)
+{
+    (void)frame;
+    SSD1325Z2_flush(&dev);
+}
+
+static void SSD1325Z2_Bench_clear (uint32_t frame)
+{
+    (void)frame;
+    SSD1325Z2_clear(&dev);
+}
+
+static void SSD1325Z2_Bench_statusLine (uint32_t frame)
+{
+    uint8_t text [24];
+    uint8_t y = dev.gdl.height - GDL_DEFAULT_FONT_HEIGHT;
+
+    snprintf((char*)text,sizeof(text),"T=%5lu.%lu C",
+             (unsigned long)(frame / 10),(unsigned long)(frame % 10));
+    SSD1325Z2_drawString(&dev,0,y,text,SSD1325Z2_GRAYSCALE_15,SSD1325Z2_GRAYSCALE_0,1);
+    SSD1325Z2_flushPart(&dev,0,dev.gdl.width-1,y,dev.gdl.height-1);
+}
+
+static void SSD1325Z2_Bench_filledRectangles (uint32_t frame)
+{
+    // A background and some panels
+    SSD1325Z2_drawRectangle(&dev,0,0,dev.gdl.width,dev.gdl.height,SSD1325Z2_GRAYSCALE_1,TRUE);
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        SSD1325Z2_drawRectangle(&dev,(i * 21 + frame) % 100,(i * 11) % 40,
+                                27,23,(SSD1325Z2_GrayScale)(4 + i),TRUE);
+    }
+    SSD1325Z2_flush(&dev);
+}
+
+static void SSD1325Z2_Bench_splash4 (uint32_t frame)
+{
+    (void)frame;
+    SSD1325Z2_drawPicture(&dev,0,0,dev.gdl.width,dev.gdl.height,splash4,GDL_PICTURETYPE_4BIT);
+    SSD1325Z2_flush(&dev);
+}
+
+static void SSD1325Z2_Bench_splash1 (uint32_t frame)
+{
+    (void)frame;
+    SSD1325Z2_drawPicture(&dev,0,0,dev.gdl.width,dev.gdl.height,splash1,GDL_PICTURETYPE_1BIT);
+    SSD1325Z2_flush(&dev);
+}
+
+static void SSD1325Z2_Bench_crossfade (uint32_t frame)
+{
+    SSD1325Z2_blendArea(&dev,NULL,splash4,(uint8_t)(frame % 16));
+    SSD1325Z2_flush(&dev);
+}
+
+static void SSD1325Z2_Bench_chart (uint32_t frame)
+{
+    uint8_t height = dev.gdl.height;
+
+    SSD1325Z2_drawRectangle(&dev,0,0,dev.gdl.width,height,SSD1325Z2_GRAYSCALE_0,TRUE);
+    // Grid
+    for (uint8_t x = 0; x < dev.gdl.width; x += 16)
+        SSD1325Z2_drawVLine(&dev,x,0,height-1,SSD1325Z2_GRAYSCALE_3);
+    for (uint8_t y = 0; y < height; y += 16)
+        SSD1325Z2_drawHLine(&dev,0,y,dev.gdl.width-1,SSD1325Z2_GRAYSCALE_3);
+    // Trend
+    uint8_t last = height/2;
+    for (uint8_t x = 4; x < dev.gdl.width; x += 4)
+    {
+        uint8_t y = (uint8_t)(((x + frame) * 37) % (height - 8)) + 4;
+        SSD1325Z2_drawLine(&dev,x-4,last,x,y,SSD1325Z2_GRAYSCALE_15);
+        last = y;
+    }
+    SSD1325Z2_flush(&dev);
+}
+
+static void SSD1325Z2_Bench_smoothChart (uint32_t frame)
+{
+    uint8_t height = dev.gdl.height;
+
+    SSD1325Z2_drawRectangle(&dev,0,0,dev.gdl.width,height,SSD1325Z2_GRAYSCALE_0,TRUE);
+    // Trend
+    uint8_t last = height/2;
+    for (uint8_t x = 4; x < dev.gdl.width; x += 4)
+    {
+        uint8_t y = (uint8_t)(((x + frame) * 37) % (height - 8)) + 4;
+        SSD1325Z2_drawThickLine(&dev,x-4,last,x,y,2,SSD1325Z2_GRAYSCALE_15);
+        last = y;
+    }
+    SSD1325Z2_flush(&dev);
+}
+
+typedef struct _SSD1325Z2_BenchWorkload
+{
+    const char* name;
+    void (*run)(uint32_t frame);
+} SSD1325Z2_BenchWorkload;
+
+static const SSD1325Z2_BenchWorkload SSD1325Z2_benchWorkloads[] =
+{
+    {"full_flush",        SSD1325Z2_Bench_fullFlush},
+    {"clear",             SSD1325Z2_Bench_clear},
+    {"status_line",       SSD1325Z2_Bench_statusLine},
+    {"filled_rectangles", SSD1325Z2_Bench_filledRectangles},
+    {"splash_4bit",       SSD1325Z2_Bench_splash4},
+    {"splash_1bit",       SSD1325Z2_Bench_splash1},
+    {"crossfade",         SSD1325Z2_Bench_crossfade},
+    {"line_chart",        SSD1325Z2_Bench_chart},
+    {"smooth_chart",      SSD1325Z2_Bench_smoothChart},
+};
+
+static double SSD1325Z2_Bench_now (void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC,&now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+int main (void)
+{
+    for (uint16_t i = 0; i < sizeof(splash4); i++)
+        splash4[i] = (uint8_t)((i * 7) ^ (i >> 5));
+    for (uint16_t i = 0; i < sizeof(splash1); i++)
+        splash1[i] = (uint8_t)((i * 13) ^ (i >> 4));
+
+    SSD1325Z2_Sim_init(&bench.sim,WARCOMEB_SSD1325Z2_WIDTH,WARCOMEB_SSD1325Z2_HEIGHT);
+    dev.gdl.delayTime = SSD1325Z2_Bench_delay;
+    dev.gdl.product = SSD1325Z2_PRODUCT_RAYSTAR_REX012864F;
+    SSD1325Z2_initStart(&dev,&SSD1325Z2_benchBusOps,&bench,0);
+    SSD1325Z2_initPoll(&dev,WARCOMEB_SSD1325Z2_POWERUP_DELAY);
+
+    printf("workload,frames,commands,command_bytes,data_bytes,transactions,gpio_toggles,ns_per_frame\n");
+
+    for (uint8_t i = 0; i < sizeof(SSD1325Z2_benchWorkloads)/sizeof(SSD1325Z2_benchWorkloads[0]); i++)
+    {
+        const SSD1325Z2_BenchWorkload* workload = &SSD1325Z2_benchWorkloads[i];
+
+        // Start every workload from the same state
+        memset(dev.buffer,0x00,WARCOMEB_SSD1325Z2_BUFFERDIMENSION);
+        SSD1325Z2_flush(&dev);
+        SSD1325Z2_Sim_resetCounters(&bench.sim);
+        bench.gpioToggles = 0;
+
+        double start = SSD1325Z2_Bench_now();
+        for (uint32_t frame = 0; frame < SSD1325Z2_BENCH_FRAMES; frame++)
+            workload->run(frame);
+        double elapsed = SSD1325Z2_Bench_now() - start;
+
+        printf("%s,%u,%.1f,%.1f,%.1f,%.1f,%.1f,%.0f\n",
+               workload->name,
+               SSD1325Z2_BENCH_FRAMES,
+               (double)bench.sim.commands / SSD1325Z2_BENCH_FRAMES,
+               (double)bench.sim.commandBytes / SSD1325Z2_BENCH_FRAMES,
+               (double)bench.sim.dataBytes / SSD1325Z2_BENCH_FRAMES,
+               (double)bench.sim.transactions / SSD1325Z2_BENCH_FRAMES,
+               (double)bench.gpioToggles / SSD1325Z2_BENCH_FRAMES,
+               elapsed / SSD1325Z2_BENCH_FRAMES);
+    }
+    return 0;
+}
@@ -29,6 +29,9 @@
 
 #include <string.h>
 
+#define SSD1325Z2_CMD_ACCELERATIONOPTIONS        0x23 /**< Graphic acceleration options */
+#define SSD1325Z2_CMD_DRAWRECTANGLE              0x24 /**< Draw rectangle with the controller */
+#define SSD1325Z2_CMD_COPY                       0x25 /**< Copy an area with the controller */
 #define SSD1325Z2_CMD_SETCOLUMNADDR              0x15
 #define SSD1325Z2_CMD_SETROWADDR                 0x75
 #define SSD1325Z2_CMD_SETCONTRAST                0x81
@@ -40,6 +43,7 @@
 #define SSD1325Z2_CMD_DISPLAYINVERSE             0xA7
 #define SSD1325Z2_CMD_DISPLAYOFF                 0xAE
 #define SSD1325Z2_CMD_DISPLAYON                  0xAF
+#define SSD1325Z2_CMD_GRAYSCALETABLE             0xB8 /**< Set gray scale table */
 
 #define SSD1325Z2_REMAP_COLUMN                   0x01 /**< Enable column address remap */
 #define SSD1325Z2_REMAP_NIBBLE                   0x02 /**< Enable nibble remap */
@@ -47,6 +51,80 @@
 #define SSD1325Z2_REMAP_COM                      0x10 /**< Enable COM remap */
 #define SSD1325Z2_REMAP_ODDEVEN_COM              0x40 /**< Enable COM split odd/even */
 
+#define SSD1325Z2_RAM_ROWS                       80 /**< Rows of the display RAM */
+
+#define SSD1325Z2_ACCELERATION_FILL              0x01 /**< Draw rectangle fills the area */
+
+#define SSD1325Z2_FRAME_INDEX                    0x03 /**< Index of the newest frame */
+#define SSD1325Z2_FRAME_FRESH                    0x04 /**< Newest frame not yet displayed */
+
+/**
+ * Bytes of commands needed to select a new window into the display.
+ */
+#define SSD1325Z2_WINDOW_COMMAND_BYTES           6
+
+/**
+ * Extra area, in pixels, accepted when two dirty areas are merged: it is about
+ * the cost of the commands needed to send a separate window.
+ */
+#define SSD1325Z2_DIRTY_MERGE_THRESHOLD          (2 * SSD1325Z2_WINDOW_COMMAND_BYTES)
+
+/**
+ * Bytes of a row of the buffer, and of the whole buffer. With the size fixed
+ * at build time they are constants, so the offsets of the rows are shifts
+ * when the half width is a power of two.
+ */
+#if defined WARCOMEB_SSD1325Z2_USE_EXTERNAL_BUFFER
+#define SSD1325Z2_STRIDE(dev)                    ((dev)->gdl.width/2)
+#define SSD1325Z2_BUFFER_SIZE(dev)               ((uint16_t)SSD1325Z2_STRIDE(dev) * SSD1325Z2_BUFFER_ROWS((dev)->gdl.height))
+#define SSD1325Z2_MAX_WIDTH                      128
+#else
+#define SSD1325Z2_STRIDE(dev)                    (WARCOMEB_SSD1325Z2_WIDTH/2)
+#define SSD1325Z2_BUFFER_SIZE(dev)               (WARCOMEB_SSD1325Z2_BUFFERDIMENSION)
+#define SSD1325Z2_MAX_WIDTH                      (WARCOMEB_SSD1325Z2_WIDTH)
+#endif
+
+/**
+ * First and last row of the display stored into the buffer.
+ */
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+#define SSD1325Z2_BUFFER_TOP(dev)                ((dev)->bandStart)
+#define SSD1325Z2_BUFFER_BOTTOM(dev)             ((dev)->bandStop)
+#else
+#define SSD1325Z2_BUFFER_TOP(dev)                0
+#define SSD1325Z2_BUFFER_BOTTOM(dev)             ((dev)->gdl.height - 1)
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_STATISTICS
+#define SSD1325Z2_COUNT(dev,counter,value) ((dev)->statistics.counter += (value))
+#define SSD1325Z2_BEGIN(dev,operation) do {                                 \
+    if ((dev)->operationBegin != NULL) (dev)->operationBegin(dev,operation); \
+    } while (0)
+#define SSD1325Z2_END(dev,operation) do {                                   \
+    if ((dev)->operationEnd != NULL) (dev)->operationEnd(dev,operation);     \
+    } while (0)
+#else
+#define SSD1325Z2_COUNT(dev,counter,value)
+#define SSD1325Z2_BEGIN(dev,operation)
+#define SSD1325Z2_END(dev,operation)
+#endif
+
+/**
+ * While a display list is recorded, the drawing functions that are not
+ * recorded return at once: they would change the buffer out of the order of
+ * the list. The commit returns the error.
+ */
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+#define SSD1325Z2_REJECT_RECORDING(dev,result) do {                         \
+    if ((dev)->isRecording) { (dev)->isListLost = TRUE; return result; }    \
+    } while (0)
+#else
+#define SSD1325Z2_REJECT_RECORDING(dev,result)
+#endif
+
+#define SSD1325Z2_I2C_CONTROL_CONTINUATION       0x80 /**< Another control byte follows the next byte */
+#define SSD1325Z2_I2C_CONTROL_DATA               0x40 /**< The following bytes are data */
+
 #define SSD1325Z2_write(value) do {                                         \
     ((value & 0x01) > 0) ? Gpio_set(dev->gdl.d0) : Gpio_clear(dev->gdl.d0); \
     ((value & 0x02) > 0) ? Gpio_set(dev->gdl.d1) : Gpio_clear(dev->gdl.d1); \
@@ -58,304 +136,3092 @@
     ((value & 0x80) > 0) ? Gpio_set(dev->gdl.d7) : Gpio_clear(dev->gdl.d7); \
     } while (0)
 
-static void SSD1325Z2_sendCommand (SSD1325Z2_DeviceHandle dev, uint8_t command)
-{
 #if defined WARCOMEB_GDL_PARALLEL
 
-    Gpio_set(dev->gdl.rd);
-    Gpio_clear(dev->gdl.cs);
-    Gpio_set(dev->gdl.wr);
-    // Is command message
-    Gpio_clear(dev->gdl.dc);
-    // Enable writing
-    Gpio_clear(dev->gdl.wr);
-    SSD1325Z2_write(command);
-    // Restore write pin
-    Gpio_set(dev->gdl.wr);
-    // Disable device
-    Gpio_set(dev->gdl.cs);
-
-#elif defined WARCOMEB_GDL_I2C
+static void SSD1325Z2_gpioWrite (SSD1325Z2_DeviceHandle dev, uint8_t value)
+{
+    SSD1325Z2_write(value);
+}
 
-#elif defined WARCOMEB_GDL_SPI
+static void SSD1325Z2_portWrite (SSD1325Z2_DeviceHandle dev, uint8_t value)
+{
+    SSD1325Z2_ParallelPort* port = &dev->port;
+    uint32_t setMask;
 
+    if (port->shift != 0xFF)
+    {
+        setMask = (uint32_t)value << port->shift;
+    }
+    else
+    {
+#if defined WARCOMEB_SSD1325Z2_PARALLEL_PORT_LUT
+        setMask = port->lut[value];
+#else
+        setMask = 0;
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            if (value & (1 << i)) setMask |= port->pinMask[i];
+        }
 #endif
+    }
+
+    if (port->clearRegister != NULL)
+    {
+        *port->setRegister = setMask;
+        *port->clearRegister = port->mask ^ setMask;
+    }
+    else
+    {
+        *port->setRegister = setMask | ((port->mask ^ setMask) << 16);
+    }
 }
 
-static void SSD1325Z2_sendData (SSD1325Z2_DeviceHandle dev, uint8_t value)
+/**
+ * The function sends a byte with the 8080 parallel interface.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] isData TRUE for data message, FALSE for command message
+ * @param[in] value The byte to send
+ * @param[in] write The function that drives the data pins
+ */
+static inline void SSD1325Z2_parallelSend (SSD1325Z2_DeviceHandle dev,
+                                           bool isData,
+                                           uint8_t value,
+                                           void (*write)(SSD1325Z2_DeviceHandle, uint8_t))
 {
-#if defined WARCOMEB_GDL_PARALLEL
-
     Gpio_set(dev->gdl.rd);
     Gpio_clear(dev->gdl.cs);
     Gpio_set(dev->gdl.wr);
-    // is data message
-    Gpio_set(dev->gdl.dc);
+    // Select data or command message
+    (isData) ? Gpio_set(dev->gdl.dc) : Gpio_clear(dev->gdl.dc);
     // Enable writing
     Gpio_clear(dev->gdl.wr);
-    SSD1325Z2_write(value);
+    write(dev,value);
     // Restore write pin
     Gpio_set(dev->gdl.wr);
     // Disable device
     Gpio_set(dev->gdl.cs);
-
-#elif defined WARCOMEB_GDL_I2C
-
-#elif defined WARCOMEB_GDL_SPI
-
-#endif
 }
 
 /**
- * The function set the current position into the display. The values are related to
- * the internal buffer of the display.
+ * The function sends a block of data bytes with the 8080 parallel interface.
+ * The device is selected only once and only the write pin is strobed for
+ * every byte.
  *
  * @param[in] dev The handle of the device
- * @param[in] xStart The x start position into the buffer
- * @param[in] xStop The x stop position into the buffer
- * @param[in] yStart The y start position into the buffer
- * @param[in] yStop The y stop position into the buffer
- * @return Return an error if the requested position is wrong,
- *         GDL_ERRORS_OK otherwise.
+ * @param[in] data The bytes to send
+ * @param[in] length The number of bytes
+ * @param[in] write The function that drives the data pins
  */
-static GDL_Errors SSD1325Z2_setBufferPosition (SSD1325Z2_DeviceHandle dev,
-                                               uint8_t xStart,
-                                               uint8_t xStop,
-                                               uint8_t yStart,
-                                               uint8_t yStop)
+static inline void SSD1325Z2_parallelSendBlock (SSD1325Z2_DeviceHandle dev,
+                                                const uint8_t* data,
+                                                uint16_t length,
+                                                void (*write)(SSD1325Z2_DeviceHandle, uint8_t))
 {
-    if ((xStart >= dev->gdl.width) || (yStart >= dev->gdl.height))
-        return GDL_ERRORS_WRONG_POSITION;
-
-    if ((xStop >= dev->gdl.width) || (yStop >= dev->gdl.height))
-        return GDL_ERRORS_WRONG_POSITION;
-
-    // Set column address
-    SSD1325Z2_sendCommand(dev,SSD1325Z2_CMD_SETCOLUMNADDR);
-    SSD1325Z2_sendCommand(dev,xStart/2);
-    SSD1325Z2_sendCommand(dev,xStop/2);
+    Gpio_set(dev->gdl.rd);
+    Gpio_clear(dev->gdl.cs);
+    // is data message
+    Gpio_set(dev->gdl.dc);
 
-    // Set row address
-    SSD1325Z2_sendCommand(dev,SSD1325Z2_CMD_SETROWADDR);
-    SSD1325Z2_sendCommand(dev,yStart);
-    SSD1325Z2_sendCommand(dev,yStop);
+    for (uint16_t i = 0; i < length; i++)
+    {
+        // Enable writing
+        Gpio_clear(dev->gdl.wr);
+        write(dev,data[i]);
+        // Restore write pin
+        Gpio_set(dev->gdl.wr);
+    }
 
-    return GDL_ERRORS_OK;
+    // Disable device
+    Gpio_set(dev->gdl.cs);
 }
 
-void SSD1325Z2_init (SSD1325Z2_DeviceHandle dev)
+static void SSD1325Z2_gpioWriteCommand (void* bus, uint8_t command)
 {
-    // Set the device model
-    dev->gdl.model = GDL_MODELTYPE_SSD1325;
+    SSD1325Z2_parallelSend((SSD1325Z2_DeviceHandle)bus,FALSE,command,SSD1325Z2_gpioWrite);
+}
 
-    // Save display size
-    dev->gdl.height = WARCOMEB_SSD1325Z2_HEIGHT;
-    dev->gdl.width = WARCOMEB_SSD1325Z2_WIDTH;
+static void SSD1325Z2_gpioWriteData (void* bus, uint8_t value)
+{
+    SSD1325Z2_parallelSend((SSD1325Z2_DeviceHandle)bus,TRUE,value,SSD1325Z2_gpioWrite);
+}
 
-    // Save default font size
-    dev->gdl.fontSize = 1;
-    dev->gdl.useCustomFont = FALSE;
+static void SSD1325Z2_gpioWriteDataBlock (void* bus, const uint8_t* data, uint16_t length)
+{
+    SSD1325Z2_parallelSendBlock((SSD1325Z2_DeviceHandle)bus,data,length,SSD1325Z2_gpioWrite);
+}
 
-    // Save callback for drawing pixel
-    dev->gdl.drawPixel = SSD1325Z2_drawPixel;
+static void SSD1325Z2_portWriteCommand (void* bus, uint8_t command)
+{
+    SSD1325Z2_parallelSend((SSD1325Z2_DeviceHandle)bus,FALSE,command,SSD1325Z2_portWrite);
+}
 
-    memset(dev->buffer, 0x00, WARCOMEB_SSD1325Z2_BUFFERDIMENSION);
+static void SSD1325Z2_portWriteData (void* bus, uint8_t value)
+{
+    SSD1325Z2_parallelSend((SSD1325Z2_DeviceHandle)bus,TRUE,value,SSD1325Z2_portWrite);
+}
 
-#if defined WARCOMEB_GDL_PARALLEL
+static void SSD1325Z2_portWriteDataBlock (void* bus, const uint8_t* data, uint16_t length)
+{
+    SSD1325Z2_parallelSendBlock((SSD1325Z2_DeviceHandle)bus,data,length,SSD1325Z2_portWrite);
+}
 
-    Gpio_config(dev->gdl.d0,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.d1,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.d2,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.d3,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.d4,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.d5,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.d6,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.d7,GPIO_PINS_OUTPUT);
-
-    Gpio_config(dev->gdl.rd,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.dc,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.rs,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.cs,GPIO_PINS_OUTPUT);
-    Gpio_config(dev->gdl.wr,GPIO_PINS_OUTPUT);
+/** Parallel interface with every data pin written by itself */
+static const SSD1325Z2_BusOps SSD1325Z2_gpioBusOps =
+{
+    .writeCommand        = SSD1325Z2_gpioWriteCommand,
+    .writeCommandBlock   = NULL,
+    .writeData           = SSD1325Z2_gpioWriteData,
+    .writeDataBlock      = SSD1325Z2_gpioWriteDataBlock,
+    .writeDataBlockAsync = NULL,
+};
 
-    Gpio_set(dev->gdl.dc);
-    Gpio_set(dev->gdl.rd);
-    Gpio_set(dev->gdl.wr);
-    Gpio_set(dev->gdl.cs);
-    Gpio_set(dev->gdl.rs);
+/** Parallel interface with the data pins written with a port store */
+static const SSD1325Z2_BusOps SSD1325Z2_portBusOps =
+{
+    .writeCommand        = SSD1325Z2_portWriteCommand,
+    .writeCommandBlock   = NULL,
+    .writeData           = SSD1325Z2_portWriteData,
+    .writeDataBlock      = SSD1325Z2_portWriteDataBlock,
+    .writeDataBlockAsync = NULL,
+};
 
-#elif defined WARCOMEB_GDL_I2C
+/**
+ * The function computes the masks used to write the data port.
+ *
+ * @param[in] port The data port description
+ */
+static void SSD1325Z2_configPort (SSD1325Z2_ParallelPort* port)
+{
+    port->mask = 0;
+    port->shift = 0xFF;
+    for (uint8_t i = 0; i < 8; i++)
+        port->mask |= port->pinMask[i];
 
-#elif defined WARCOMEB_GDL_SPI
+    // Search D0 position and check that the other pins follow it
+    for (uint8_t i = 0; i <= 24; i++)
+    {
+        if (port->pinMask[0] == ((uint32_t)1 << i))
+        {
+            uint8_t j = 1;
+            while ((j < 8) && (port->pinMask[j] == ((uint32_t)1 << (i + j)))) j++;
+            if (j == 8) port->shift = i;
+            break;
+        }
+    }
 
+#if defined WARCOMEB_SSD1325Z2_PARALLEL_PORT_LUT
+    for (uint16_t value = 0; value < 256; value++)
+    {
+        port->lut[value] = 0;
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            if (value & (1 << i)) port->lut[value] |= port->pinMask[i];
+        }
+    }
 #endif
+}
 
-    SSD1325Z2_sendCommand(dev,SSD1325Z2_CMD_DISPLAYON);
-    // Wait 100ms after on
-    dev->gdl.delayTime(100);
-
-    // Set display to normal
-    SSD1325Z2_sendCommand(dev,SSD1325Z2_CMD_DISPLAYNORMAL);
+#elif defined WARCOMEB_GDL_I2C
 
-    // Select segment re-map, COM scan direction, COM hardware configuration and
-    // de-select level
-    // They depend on producer choice
-    switch (dev->gdl.product)
+/**
+ * The function sends bytes with the I2C interface, using transactions of
+ * the maximum allowed length. The continuation bit of the control byte is
+ * cleared, so all the bytes of the transaction are commands or data: with
+ * the bit set, another control byte would precede every following byte.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] control The control byte of every transaction
+ * @param[in] data The bytes to send
+ * @param[in] length The number of bytes
+ */
+static void SSD1325Z2_i2cSend (SSD1325Z2_DeviceHandle dev,
+                               uint8_t control,
+                               const uint8_t* data,
+                               uint16_t length)
+{
+    while (length > 0)
     {
-    case SSD1325Z2_PRODUCT_RAYSTAR_REX012864F:
-        // REX012864F: enable nibble-remap and COM split odd/even
-        SSD1325Z2_sendCommand(dev,SSD1325Z2_CMD_SEGMENTREMAP);
-        SSD1325Z2_sendCommand(dev,SSD1325Z2_REMAP_ODDEVEN_COM | SSD1325Z2_REMAP_NIBBLE);
+        uint16_t size = (length > dev->maxTransaction) ? dev->maxTransaction : length;
 
-        SSD1325Z2_sendCommand(dev,SSD1325Z2_CMD_STARTLINE);
-        SSD1325Z2_sendCommand(dev,0);
-        break;
+        dev->i2cEngine->write(dev->i2cContext,dev->address,control,data,size);
+        data += size;
+        length -= size;
     }
 }
 
-GDL_Errors SSD1325Z2_drawPixel (SSD1325Z2_DeviceHandle dev,
-                                uint8_t xPos,
-                                uint8_t yPos,
-							    SSD1325Z2_GrayScale color)
+static void SSD1325Z2_i2cWriteCommand (void* bus, uint8_t command)
 {
-    if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
-        return GDL_ERRORS_WRONG_POSITION;
-
-    uint16_t pos = ((uint16_t) xPos/2) + ((uint16_t) yPos*(dev->gdl.width/2));
-
-    if (xPos%2)
-        dev->buffer[pos] = ((color & 0x0F) | (dev->buffer[pos] & 0xF0));
-    else
-        dev->buffer[pos] = (((color << 4) & 0xF0) | (dev->buffer[pos] & 0x0F));
+    SSD1325Z2_i2cSend((SSD1325Z2_DeviceHandle)bus,0x00,&command,1);
+}
 
-    return GDL_ERRORS_OK;
+static void SSD1325Z2_i2cWriteCommandBlock (void* bus, const uint8_t* commands, uint16_t length)
+{
+    SSD1325Z2_i2cSend((SSD1325Z2_DeviceHandle)bus,0x00,commands,length);
 }
 
-void SSD1325Z2_flush (SSD1325Z2_DeviceHandle dev)
+static void SSD1325Z2_i2cWriteData (void* bus, uint8_t value)
 {
-    // Set the cursor to the starting point of the display
-    // Print all the buffer
-    SSD1325Z2_setBufferPosition(dev,0,dev->gdl.width-1,0,dev->gdl.height-1);
+    SSD1325Z2_i2cSend((SSD1325Z2_DeviceHandle)bus,SSD1325Z2_I2C_CONTROL_DATA,&value,1);
+}
 
-    for (uint16_t i = 0; i < WARCOMEB_SSD1325Z2_BUFFERDIMENSION; i++)
-    {
-        SSD1325Z2_sendData(dev,dev->buffer[i]);
-    }
+static void SSD1325Z2_i2cWriteDataBlock (void* bus, const uint8_t* data, uint16_t length)
+{
+    SSD1325Z2_i2cSend((SSD1325Z2_DeviceHandle)bus,SSD1325Z2_I2C_CONTROL_DATA,data,length);
 }
 
-void SSD1325Z2_flushPart (SSD1325Z2_DeviceHandle dev,
-                          uint8_t xStart,
-                          uint8_t xStop,
-                          uint8_t yStart,
-                          uint8_t yStop)
+/** I2C interface */
+static const SSD1325Z2_BusOps SSD1325Z2_i2cBusOps =
 {
-    // Set the part of the display where change the pixels
-    GDL_Errors error = SSD1325Z2_setBufferPosition(dev,xStart,xStop,yStart,yStop);
-    if (error != GDL_ERRORS_OK) return;
+    .writeCommand        = SSD1325Z2_i2cWriteCommand,
+    .writeCommandBlock   = SSD1325Z2_i2cWriteCommandBlock,
+    .writeData           = SSD1325Z2_i2cWriteData,
+    .writeDataBlock      = SSD1325Z2_i2cWriteDataBlock,
+    .writeDataBlockAsync = NULL,
+};
 
-    uint8_t xStartHalf = xStart/2;
-    uint8_t xStopHalf = xStop/2;
-    uint8_t widthHalf = dev->gdl.width/2;
+#elif defined WARCOMEB_GDL_SPI
 
-    for (uint8_t i = yStart; i <= yStop; i++)
+/**
+ * The default engine: it drives clock and data pins by itself, with the
+ * SPI mode 0 and the most significant bit first.
+ */
+static void SSD1325Z2_gpioSpiWrite (void* context, const uint8_t* data, uint16_t length)
+{
+    SSD1325Z2_DeviceHandle dev = (SSD1325Z2_DeviceHandle)context;
+
+    for (uint16_t i = 0; i < length; i++)
     {
-        for (uint8_t j = xStartHalf; j <= xStopHalf; j++)
+        uint8_t value = data[i];
+        for (uint8_t mask = 0x80; mask != 0; mask >>= 1)
         {
-            SSD1325Z2_sendData(dev,dev->buffer[j + (i * widthHalf)]);
+            (value & mask) ? Gpio_set(dev->sdinPin) : Gpio_clear(dev->sdinPin);
+            // Data is sampled on the rising edge
+            Gpio_set(dev->sclkPin);
+            Gpio_clear(dev->sclkPin);
         }
     }
 }
 
-void SSD1325Z2_clear (SSD1325Z2_DeviceHandle dev)
+static const SSD1325Z2_SpiEngine SSD1325Z2_gpioSpiEngine =
 {
-    // Reset memory buffer
-    memset(dev->buffer, 0x00, WARCOMEB_SSD1325Z2_BUFFERDIMENSION);
-    // Flush the new buffer
-    SSD1325Z2_flush(dev);
+    .write      = SSD1325Z2_gpioSpiWrite,
+    .writeAsync = NULL,
+};
+
+/**
+ * The function sends bytes with the 4-wire SPI interface.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] isData TRUE for data message, FALSE for command message
+ * @param[in] data The bytes to send
+ * @param[in] length The number of bytes
+ */
+static void SSD1325Z2_spiSend (SSD1325Z2_DeviceHandle dev,
+                               bool isData,
+                               const uint8_t* data,
+                               uint16_t length)
+{
+    Gpio_clear(dev->csPin);
+    // Select data or command message
+    (isData) ? Gpio_set(dev->dcPin) : Gpio_clear(dev->dcPin);
+    dev->spiEngine->write(dev->spiContext,data,length);
+    // Disable device
+    Gpio_set(dev->csPin);
 }
 
-void SSD1325Z2_drawLine (SSD1325Z2_DeviceHandle dev,
-                         uint8_t xStart,
-                         uint8_t yStart,
-                         uint8_t xStop,
-                         uint8_t yStop,
-                         SSD1325Z2_GrayScale color)
+static void SSD1325Z2_spiWriteCommand (void* bus, uint8_t command)
 {
-    GDL_drawLine(&(dev->gdl),xStart,yStart,xStop,yStop,(uint8_t)color);
+    SSD1325Z2_spiSend((SSD1325Z2_DeviceHandle)bus,FALSE,&command,1);
 }
 
-void SSD1325Z2_drawHLine (SSD1325Z2_DeviceHandle dev,
-                          uint8_t xStart,
-                          uint8_t yStart,
-                          uint8_t width,
-                          SSD1325Z2_GrayScale color)
+static void SSD1325Z2_spiWriteCommandBlock (void* bus, const uint8_t* commands, uint16_t length)
 {
-    SSD1325Z2_drawLine(dev,xStart,yStart,xStart+width,yStart,color);
+    SSD1325Z2_spiSend((SSD1325Z2_DeviceHandle)bus,FALSE,commands,length);
 }
 
-void SSD1325Z2_drawVLine (SSD1325Z2_DeviceHandle dev,
-                          uint8_t xStart,
-                          uint8_t yStart,
-                          uint8_t height,
-                          SSD1325Z2_GrayScale color)
+static void SSD1325Z2_spiWriteData (void* bus, uint8_t value)
 {
-    SSD1325Z2_drawLine(dev,xStart,yStart,xStart,yStart+height,color);
+    SSD1325Z2_spiSend((SSD1325Z2_DeviceHandle)bus,TRUE,&value,1);
 }
 
-void SSD1325Z2_drawRectangle (SSD1325Z2_DeviceHandle dev,
-                              uint16_t xStart,
-                              uint16_t yStart,
-                              uint16_t width,
-                              uint16_t height,
-                              SSD1325Z2_GrayScale color,
-                              bool isFill)
+static void SSD1325Z2_spiWriteDataBlock (void* bus, const uint8_t* data, uint16_t length)
 {
-    GDL_drawRectangle(&(dev->gdl),xStart,yStart,width,height,(uint8_t)color,isFill);
+    SSD1325Z2_spiSend((SSD1325Z2_DeviceHandle)bus,TRUE,data,length);
 }
 
-GDL_Errors SSD1325Z2_drawChar (SSD1325Z2_DeviceHandle dev,
-                               uint16_t xPos,
-                               uint16_t yPos,
-                               uint8_t c,
-                               SSD1325Z2_GrayScale color,
-                               SSD1325Z2_GrayScale background,
-                               uint8_t size)
+/**
+ * The function is called by the engine at the end of an asynchronous
+ * transfer: it releases the device and forwards the event.
+ */
+static void SSD1325Z2_spiWriteDone (void* argument)
 {
-    return GDL_drawChar(&(dev->gdl),xPos,yPos,c,(uint8_t)color,(uint8_t)background,size);
+    SSD1325Z2_DeviceHandle dev = (SSD1325Z2_DeviceHandle)argument;
+
+    // Disable device
+    Gpio_set(dev->csPin);
+    dev->spiDone(dev->spiDoneArgument);
 }
 
-GDL_Errors SSD1325Z2_drawString (SSD1325Z2_DeviceHandle dev,
-                                 uint16_t xPos,
-                                 uint16_t yPos,
-                                 const uint8_t* text,
-                                 SSD1325Z2_GrayScale color,
-                                 SSD1325Z2_GrayScale background,
-                                 uint8_t size)
+static void SSD1325Z2_spiWriteDataBlockAsync (void* bus,
+                                              const uint8_t* data,
+                                              uint16_t length,
+                                              void (*done)(void* argument),
+                                              void* argument)
 {
-    uint8_t charWidth = size * GDL_DEFAULT_FONT_WIDTH;
-    GDL_Errors error;
+    SSD1325Z2_DeviceHandle dev = (SSD1325Z2_DeviceHandle)bus;
 
-    for (uint8_t i=0; text[i] != '\n' && text[i] != '\0'; i++)
+    if (dev->spiEngine->writeAsync == NULL)
     {
-        error = SSD1325Z2_drawChar(dev,(xPos + charWidth * i),yPos,text[i],color,background,size);
-        if (error != GDL_ERRORS_OK) return error;
+        SSD1325Z2_spiSend(dev,TRUE,data,length);
+        done(argument);
+        return;
     }
-    return GDL_ERRORS_OK;
+
+    dev->spiDone = done;
+    dev->spiDoneArgument = argument;
+
+    Gpio_clear(dev->csPin);
+    // is data message
+    Gpio_set(dev->dcPin);
+    dev->spiEngine->writeAsync(dev->spiContext,data,length,SSD1325Z2_spiWriteDone,dev);
 }
 
-GDL_Errors SSD1325Z2_drawPicture (SSD1325Z2_DeviceHandle dev,
-                                  uint16_t xPos,
-                                  uint16_t yPos,
-                                  uint16_t width,
-                                  uint16_t height,
-                                  const uint8_t* picture,
+/** 4-wire SPI interface */
+static const SSD1325Z2_BusOps SSD1325Z2_spiBusOps =
+{
+    .writeCommand        = SSD1325Z2_spiWriteCommand,
+    .writeCommandBlock   = SSD1325Z2_spiWriteCommandBlock,
+    .writeData           = SSD1325Z2_spiWriteData,
+    .writeDataBlock      = SSD1325Z2_spiWriteDataBlock,
+    .writeDataBlockAsync = SSD1325Z2_spiWriteDataBlockAsync,
+};
+
+#endif
+
+/**
+ * The function waits the end of the asynchronous flush, if any, before
+ * using the bus.
+ */
+static inline void SSD1325Z2_waitBus (SSD1325Z2_DeviceHandle dev)
+{
+    while (dev->isFlushing);
+}
+
+static inline void SSD1325Z2_sendCommand (SSD1325Z2_DeviceHandle dev, uint8_t command)
+{
+    SSD1325Z2_waitBus(dev);
+    SSD1325Z2_COUNT(dev,commandBytes,1);
+    dev->busOps->writeCommand(dev->bus,command);
+}
+
+static void SSD1325Z2_sendCommandBlock (SSD1325Z2_DeviceHandle dev,
+                                        const uint8_t* commands,
+                                        uint16_t length)
+{
+    SSD1325Z2_waitBus(dev);
+    SSD1325Z2_COUNT(dev,commandBytes,length);
+    if (dev->busOps->writeCommandBlock != NULL)
+    {
+        dev->busOps->writeCommandBlock(dev->bus,commands,length);
+    }
+    else
+    {
+        for (uint16_t i = 0; i < length; i++)
+            dev->busOps->writeCommand(dev->bus,commands[i]);
+    }
+}
+
+static inline void SSD1325Z2_sendDataBlock (SSD1325Z2_DeviceHandle dev,
+                                            const uint8_t* data,
+                                            uint16_t length)
+{
+    SSD1325Z2_waitBus(dev);
+    SSD1325Z2_COUNT(dev,dataBytes,length);
+    dev->busOps->writeDataBlock(dev->bus,data,length);
+}
+
+/**
+ * The function returns the offset into the buffer of a row of the display.
+ * Without bands the rows are a ring, rotated by the scroll like the display
+ * RAM: the next row is not always a stride after.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] yPos The row of the display, into the buffer
+ * @return The offset of the first byte of the row
+ */
+static inline uint16_t SSD1325Z2_rowOffset (SSD1325Z2_DeviceHandle dev, uint8_t yPos)
+{
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+    return (uint16_t)(yPos - dev->bandStart) * SSD1325Z2_STRIDE(dev);
+#else
+    uint8_t row = yPos + dev->ringStart;
+    if (row >= dev->gdl.height) row -= dev->gdl.height;
+    return (uint16_t)row * SSD1325Z2_STRIDE(dev);
+#endif
+}
+
+/**
+ * The function returns the last row of a window that can be sent with a
+ * single block: it wraps neither at the end of the display RAM nor at the
+ * end of the ring of the buffer.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] yStart The first row of the window
+ * @param[in] yStop The last row of the window
+ * @return The last row of the first part of the window
+ */
+static uint8_t SSD1325Z2_partStop (SSD1325Z2_DeviceHandle dev, uint8_t yStart, uint8_t yStop)
+{
+    uint8_t yWrap = SSD1325Z2_RAM_ROWS - dev->startLine;
+    if ((yStart < yWrap) && (yStop >= yWrap))
+        yStop = yWrap - 1;
+
+#if !defined WARCOMEB_SSD1325Z2_USE_BANDS
+    uint8_t yRing = dev->gdl.height - dev->ringStart;
+    if ((yStart < yRing) && (yStop >= yRing))
+        yStop = yRing - 1;
+#endif
+    return yStop;
+}
+
+#if defined WARCOMEB_SSD1325Z2_USE_ACCELERATION
+/**
+ * The function waits the end of the last graphic acceleration command, when
+ * it uses an area of the display RAM that overlaps the requested one.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] columnStart The first column of the display RAM, two pixels each
+ * @param[in] columnStop The last column of the display RAM
+ * @param[in] rowStart The first row of the display RAM
+ * @param[in] rowStop The last row of the display RAM
+ */
+static void SSD1325Z2_waitAcceleration (SSD1325Z2_DeviceHandle dev,
+                                        uint8_t columnStart,
+                                        uint8_t columnStop,
+                                        uint8_t rowStart,
+                                        uint8_t rowStop)
+{
+    const SSD1325Z2_Rect* area = &dev->accelerationArea;
+    if (dev->isAccelerating &&
+        (area->xStart <= columnStop) && (area->xStop >= columnStart) &&
+        (area->yStart <= rowStop) && (area->yStop >= rowStart))
+    {
+        dev->gdl.delayTime(WARCOMEB_SSD1325Z2_ACCELERATION_DELAY);
+        dev->isAccelerating = FALSE;
+    }
+}
+
+/**
+ * The function sends a graphic acceleration command. The controller runs one
+ * command at a time, so the previous one is waited when it can still be
+ * running; the new one is waited only by the accesses to its area.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] commands The command with its arguments
+ * @param[in] length The number of bytes of the command
+ * @param[in] area Columns and rows of the display RAM used by the command
+ */
+static void SSD1325Z2_sendAcceleration (SSD1325Z2_DeviceHandle dev,
+                                        const uint8_t* commands,
+                                        uint8_t length,
+                                        const SSD1325Z2_Rect* area)
+{
+    SSD1325Z2_waitAcceleration(dev,0,0xFF,0,0xFF);
+
+    SSD1325Z2_sendCommandBlock(dev,commands,length);
+    dev->accelerationArea = *area;
+    dev->isAccelerating = TRUE;
+}
+#endif
+
+/**
+ * The function set the current position into the display. The values are related to
+ * the internal buffer of the display, and the rows are moved by the start line:
+ * the window must not wrap at the end of the display RAM.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The x start position into the buffer
+ * @param[in] xStop The x stop position into the buffer
+ * @param[in] yStart The y start position into the buffer
+ * @param[in] yStop The y stop position into the buffer
+ * @return Return an error if the requested position is wrong,
+ *         GDL_ERRORS_OK otherwise.
+ */
+static GDL_Errors SSD1325Z2_setBufferPosition (SSD1325Z2_DeviceHandle dev,
+                                               uint8_t xStart,
+                                               uint8_t xStop,
+                                               uint8_t yStart,
+                                               uint8_t yStop)
+{
+    if ((xStart >= dev->gdl.width) || (yStart >= dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    if ((xStop >= dev->gdl.width) || (yStop >= dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    // The incremental flush must set its window again
+    dev->isStepWindow = FALSE;
+
+    // The display RAM is a ring of rows, rotated by the start line
+    yStart = (yStart + dev->startLine) % SSD1325Z2_RAM_ROWS;
+    yStop = (yStop + dev->startLine) % SSD1325Z2_RAM_ROWS;
+
+#if defined WARCOMEB_SSD1325Z2_USE_ACCELERATION
+    // The data can't be written while the controller uses the same area
+    SSD1325Z2_waitAcceleration(dev,xStart/2,xStop/2,yStart,yStop);
+#endif
+
+    const uint8_t commands[SSD1325Z2_WINDOW_COMMAND_BYTES] =
+    {
+        // Set column address
+        SSD1325Z2_CMD_SETCOLUMNADDR, xStart/2, xStop/2,
+        // Set row address
+        SSD1325Z2_CMD_SETROWADDR, yStart, yStop,
+    };
+    SSD1325Z2_sendCommandBlock(dev,commands,SSD1325Z2_WINDOW_COMMAND_BYTES);
+
+    return GDL_ERRORS_OK;
+}
+
+/**
+ * The function sends a window of the buffer to the display.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The x start position into the buffer
+ * @param[in] xStop The x stop position into the buffer
+ * @param[in] yStart The y start position into the buffer
+ * @param[in] yStop The y stop position into the buffer
+ * @return Return an error if the requested position is wrong,
+ *         GDL_ERRORS_OK otherwise.
+ */
+static GDL_Errors SSD1325Z2_sendWindow (SSD1325Z2_DeviceHandle dev,
+                                        uint8_t xStart,
+                                        uint8_t xStop,
+                                        uint8_t yStart,
+                                        uint8_t yStop)
+{
+    // A window that wraps at the end of the display RAM, or of the ring of
+    // the buffer, is sent in parts
+    uint8_t yPart = SSD1325Z2_partStop(dev,yStart,yStop);
+    if ((yPart < yStop) && (yStop < dev->gdl.height))
+    {
+        GDL_Errors error = SSD1325Z2_sendWindow(dev,xStart,xStop,yStart,yPart);
+        if (error != GDL_ERRORS_OK) return error;
+        return SSD1325Z2_sendWindow(dev,xStart,xStop,yPart+1,yStop);
+    }
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+    if ((yStart < dev->bandStart) || (yStop > dev->bandStop))
+        return GDL_ERRORS_WRONG_POSITION;
+#endif
+
+    // Set the part of the display where change the pixels
+    GDL_Errors error = SSD1325Z2_setBufferPosition(dev,xStart,xStop,yStart,yStop);
+    if (error != GDL_ERRORS_OK) return error;
+
+    uint8_t xStartHalf = xStart/2;
+    uint8_t xStopHalf = xStop/2;
+    uint8_t widthHalf = SSD1325Z2_STRIDE(dev);
+
+    uint8_t length = xStopHalf - xStartHalf + 1;
+
+    if (length == widthHalf)
+    {
+        // Rows are consecutive into the buffer, send them with a single block
+        uint16_t start = SSD1325Z2_rowOffset(dev,yStart);
+        uint16_t size = (uint16_t)(yStop - yStart + 1) * widthHalf;
+
+        SSD1325Z2_sendDataBlock(dev,&dev->buffer[start],size);
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+        memcpy(&dev->shadow[start],&dev->buffer[start],size);
+#endif
+        return GDL_ERRORS_OK;
+    }
+
+    for (uint8_t i = yStart; i <= yStop; i++)
+    {
+        uint16_t start = xStartHalf + SSD1325Z2_rowOffset(dev,i);
+
+        SSD1325Z2_sendDataBlock(dev,&dev->buffer[start],length);
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+        memcpy(&dev->shadow[start],&dev->buffer[start],length);
+#endif
+    }
+    return GDL_ERRORS_OK;
+}
+
+/**
+ * The function returns the area of a rectangle, in pixels.
+ */
+static inline uint16_t SSD1325Z2_rectArea (const SSD1325Z2_Rect* rect)
+{
+    return (uint16_t)(rect->xStop - rect->xStart + 1) *
+           (uint16_t)(rect->yStop - rect->yStart + 1);
+}
+
+/**
+ * The function adds an area to the damage of the buffer.
+ * The area is merged with the dirty rectangle that grows less, when the growth
+ * costs less than a new window; otherwise a new dirty rectangle is used while
+ * there is room.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The x start position of the area
+ * @param[in] xStop The x stop position of the area
+ * @param[in] yStart The y start position of the area
+ * @param[in] yStop The y stop position of the area
+ */
+static void SSD1325Z2_markDirty (SSD1325Z2_DeviceHandle dev,
+                                 uint8_t xStart,
+                                 uint8_t xStop,
+                                 uint8_t yStart,
+                                 uint8_t yStop)
+{
+    SSD1325Z2_Rect area = {xStart, xStop, yStart, yStop};
+    uint16_t bestGrowth = 0xFFFF;
+    uint8_t best = 0;
+
+    for (uint8_t i = 0; i < dev->dirtyCount; i++)
+    {
+        SSD1325Z2_Rect* rect = &dev->dirty[i];
+
+        // Already inside this area, nothing to do
+        if ((xStart >= rect->xStart) && (xStop <= rect->xStop) &&
+            (yStart >= rect->yStart) && (yStop <= rect->yStop))
+            return;
+
+        SSD1325Z2_Rect merged =
+        {
+            (xStart < rect->xStart) ? xStart : rect->xStart,
+            (xStop > rect->xStop) ? xStop : rect->xStop,
+            (yStart < rect->yStart) ? yStart : rect->yStart,
+            (yStop > rect->yStop) ? yStop : rect->yStop,
+        };
+        uint16_t growth = SSD1325Z2_rectArea(&merged) - SSD1325Z2_rectArea(rect);
+        if (growth < bestGrowth)
+        {
+            bestGrowth = growth;
+            best = i;
+        }
+    }
+
+    if ((dev->dirtyCount < WARCOMEB_SSD1325Z2_DIRTY_RECTANGLES) &&
+        (bestGrowth > SSD1325Z2_rectArea(&area) + SSD1325Z2_DIRTY_MERGE_THRESHOLD))
+    {
+        dev->dirty[dev->dirtyCount++] = area;
+        return;
+    }
+
+    SSD1325Z2_Rect* rect = &dev->dirty[best];
+    if (xStart < rect->xStart) rect->xStart = xStart;
+    if (xStop > rect->xStop) rect->xStop = xStop;
+    if (yStart < rect->yStart) rect->yStart = yStart;
+    if (yStop > rect->yStop) rect->yStop = yStop;
+}
+
+#if defined WARCOMEB_SSD1325Z2_USE_ACCELERATION
+
+/**
+ * The function sends the dirty areas that overlap an area, and removes them
+ * from the damage.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The x start position of the area
+ * @param[in] xStop The x stop position of the area
+ * @param[in] yStart The y start position of the area
+ * @param[in] yStop The y stop position of the area
+ */
+static void SSD1325Z2_flushDirtyOver (SSD1325Z2_DeviceHandle dev,
+                                      uint8_t xStart,
+                                      uint8_t xStop,
+                                      uint8_t yStart,
+                                      uint8_t yStop)
+{
+    uint8_t j = 0;
+    for (uint8_t i = 0; i < dev->dirtyCount; i++)
+    {
+        SSD1325Z2_Rect* rect = &dev->dirty[i];
+        if ((rect->xStart <= xStop) && (rect->xStop >= xStart) &&
+            (rect->yStart <= yStop) && (rect->yStop >= yStart))
+        {
+            SSD1325Z2_sendWindow(dev,rect->xStart,rect->xStop,rect->yStart,rect->yStop);
+            continue;
+        }
+        dev->dirty[j++] = *rect;
+    }
+    dev->dirtyCount = j;
+}
+
+/**
+ * The function fills whole columns of the display with the draw rectangle
+ * command of the controller, and the same area of the buffer.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] columnStart The first column, two pixels each
+ * @param[in] columnStop The last column
+ * @param[in] yStart The y start position
+ * @param[in] yStop The y stop position
+ * @param[in] color The color of the area
+ */
+static void SSD1325Z2_fillColumns (SSD1325Z2_DeviceHandle dev,
+                                   uint8_t columnStart,
+                                   uint8_t columnStop,
+                                   uint8_t yStart,
+                                   uint8_t yStop,
+                                   SSD1325Z2_GrayScale color)
+{
+    // An area that wraps at the end of the display RAM is drawn in two parts
+    uint8_t yWrap = SSD1325Z2_RAM_ROWS - dev->startLine;
+    if ((yStart < yWrap) && (yStop >= yWrap))
+    {
+        SSD1325Z2_fillColumns(dev,columnStart,columnStop,yStart,yWrap-1,color);
+        SSD1325Z2_fillColumns(dev,columnStart,columnStop,yWrap,yStop,color);
+        return;
+    }
+
+    uint8_t pattern = ((color & 0x0F) << 4) | (color & 0x0F);
+    const SSD1325Z2_Rect area =
+    {
+        columnStart, columnStop,
+        (yStart + dev->startLine) % SSD1325Z2_RAM_ROWS,
+        (yStop + dev->startLine) % SSD1325Z2_RAM_ROWS,
+    };
+    const uint8_t commands[] =
+    {
+        SSD1325Z2_CMD_DRAWRECTANGLE, area.xStart, area.yStart, area.xStop, area.yStop, pattern,
+    };
+    SSD1325Z2_sendAcceleration(dev,commands,sizeof(commands),&area);
+
+    for (uint8_t i = yStart; i <= yStop; i++)
+    {
+        uint16_t start = columnStart + SSD1325Z2_rowOffset(dev,i);
+        memset(&dev->buffer[start],pattern,columnStop - columnStart + 1);
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+        memset(&dev->shadow[start],pattern,columnStop - columnStart + 1);
+#endif
+    }
+}
+
+void SSD1325Z2_setAcceleration (SSD1325Z2_DeviceHandle dev, bool isEnabled)
+{
+    dev->isAccelerated = isEnabled;
+
+    if (isEnabled)
+    {
+        const uint8_t commands[] = {SSD1325Z2_CMD_ACCELERATIONOPTIONS, SSD1325Z2_ACCELERATION_FILL};
+        SSD1325Z2_sendCommandBlock(dev,commands,sizeof(commands));
+    }
+}
+
+#endif
+
+/**
+ * Setup of the display sent after the power-up delay, for each product.
+ */
+typedef struct _SSD1325Z2_InitTable
+{
+    SSD1325Z2_Product product;
+    const uint8_t* commands;
+    uint8_t length;
+} SSD1325Z2_InitTable;
+
+static const uint8_t SSD1325Z2_initCommandsDefault[] =
+{
+    SSD1325Z2_CMD_DISPLAYNORMAL,
+};
+
+// REX012864F: enable nibble-remap and COM split odd/even
+static const uint8_t SSD1325Z2_initCommandsRex012864f[] =
+{
+    SSD1325Z2_CMD_DISPLAYNORMAL,
+    SSD1325Z2_CMD_SEGMENTREMAP, SSD1325Z2_REMAP_ODDEVEN_COM | SSD1325Z2_REMAP_NIBBLE,
+    SSD1325Z2_CMD_STARTLINE, 0,
+};
+
+static const SSD1325Z2_InitTable SSD1325Z2_initDefault =
+{
+    0, SSD1325Z2_initCommandsDefault, sizeof(SSD1325Z2_initCommandsDefault),
+};
+
+static const SSD1325Z2_InitTable SSD1325Z2_initTables[] =
+{
+    {
+        SSD1325Z2_PRODUCT_RAYSTAR_REX012864F,
+        SSD1325Z2_initCommandsRex012864f, sizeof(SSD1325Z2_initCommandsRex012864f),
+    },
+};
+
+/**
+ * The function initializes the device and the display, after the size of the
+ * display and the buffer are set.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] busOps The operations of the bus, NULL for the GDL interface
+ * @param[in] bus The argument passed to every bus operation
+ * @param[in] now The current time in milliseconds
+ */
+static void SSD1325Z2_initDevice (SSD1325Z2_DeviceHandle dev,
+                                  const SSD1325Z2_BusOps* busOps,
+                                  void* bus,
+                                  uint32_t now)
+{
+    SSD1325Z2_BEGIN(dev,SSD1325Z2_OPERATION_INIT);
+#if defined WARCOMEB_SSD1325Z2_USE_STATISTICS
+    SSD1325Z2_resetStatistics(dev);
+#endif
+
+    // Set the device model
+    dev->gdl.model = GDL_MODELTYPE_SSD1325;
+
+    // Save default font size
+    dev->gdl.fontSize = 1;
+    dev->gdl.useCustomFont = FALSE;
+
+    // Save callback for drawing pixel
+    dev->gdl.drawPixel = SSD1325Z2_drawPixel;
+
+#if defined WARCOMEB_SSD1325Z2_USE_FRAMES
+    for (uint8_t i = 0; i < SSD1325Z2_FRAMES; i++)
+        memset(dev->frames[i], 0x00, SSD1325Z2_BUFFER_SIZE(dev));
+    dev->frameRender = 0;
+    dev->frameReady = 1;
+    dev->frameDisplay = 2;
+    dev->buffer = dev->frames[dev->frameRender];
+#endif
+
+    memset(dev->buffer, 0x00, SSD1325Z2_BUFFER_SIZE(dev));
+    dev->dirtyCount = 0;
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+    dev->isShadowValid = FALSE;
+#endif
+    dev->isFlushing = FALSE;
+    dev->isStepping = FALSE;
+    dev->isStepWindow = FALSE;
+#if (WARCOMEB_SSD1325Z2_GLYPH_CACHE_ENTRIES > 0)
+    SSD1325Z2_clearGlyphCache(dev);
+#endif
+#if defined WARCOMEB_SSD1325Z2_USE_ACCELERATION
+    dev->isAccelerated = FALSE;
+    dev->isAccelerating = FALSE;
+#endif
+    dev->startLine = 0;
+#if !defined WARCOMEB_SSD1325Z2_USE_BANDS
+    dev->ringStart = 0;
+#endif
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+    dev->listLength = 0;
+    dev->isRecording = FALSE;
+    dev->isListLost = FALSE;
+#endif
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+    dev->bandStart = 0;
+    dev->bandStop = ((WARCOMEB_SSD1325Z2_BAND_ROWS > dev->gdl.height) ?
+                     dev->gdl.height : WARCOMEB_SSD1325Z2_BAND_ROWS) - 1;
+#endif
+
+    if (busOps != NULL)
+    {
+        dev->busOps = busOps;
+        dev->bus = bus;
+    }
+    else
+    {
+#if defined WARCOMEB_GDL_PARALLEL
+
+        Gpio_config(dev->gdl.d0,GPIO_PINS_OUTPUT);
+        Gpio_config(dev->gdl.d1,GPIO_PINS_OUTPUT);
+        Gpio_config(dev->gdl.d2,GPIO_PINS_OUTPUT);
+        Gpio_config(dev->gdl.d3,GPIO_PINS_OUTPUT);
+        Gpio_config(dev->gdl.d4,GPIO_PINS_OUTPUT);
+        Gpio_config(dev->gdl.d5,GPIO_PINS_OUTPUT);
+        Gpio_config(dev->gdl.d6,GPIO_PINS_OUTPUT);
+        Gpio_config(dev->gdl.d7,GPIO_PINS_OUTPUT);
+
+        Gpio_config(dev->gdl.rd,GPIO_PINS_OUTPUT);
+        Gpio_config(dev->gdl.dc,GPIO_PINS_OUTPUT);
+        Gpio_config(dev->gdl.rs,GPIO_PINS_OUTPUT);
+        Gpio_config(dev->gdl.cs,GPIO_PINS_OUTPUT);
+        Gpio_config(dev->gdl.wr,GPIO_PINS_OUTPUT);
+
+        Gpio_set(dev->gdl.dc);
+        Gpio_set(dev->gdl.rd);
+        Gpio_set(dev->gdl.wr);
+        Gpio_set(dev->gdl.cs);
+        Gpio_set(dev->gdl.rs);
+
+        // The data port can be selected later, with SSD1325Z2_setParallelPort
+        dev->busOps = &SSD1325Z2_gpioBusOps;
+        dev->bus = dev;
+
+#elif defined WARCOMEB_GDL_I2C
+
+        Gpio_config(dev->rstPin,GPIO_PINS_OUTPUT);
+        Gpio_set(dev->rstPin);
+
+        if (dev->maxTransaction == 0)
+            dev->maxTransaction = WARCOMEB_SSD1325Z2_I2C_MAX_TRANSACTION;
+        dev->busOps = &SSD1325Z2_i2cBusOps;
+        dev->bus = dev;
+
+#elif defined WARCOMEB_GDL_SPI
+
+        Gpio_config(dev->csPin,GPIO_PINS_OUTPUT);
+        Gpio_config(dev->dcPin,GPIO_PINS_OUTPUT);
+        Gpio_config(dev->rstPin,GPIO_PINS_OUTPUT);
+
+        Gpio_set(dev->csPin);
+        Gpio_set(dev->dcPin);
+        Gpio_set(dev->rstPin);
+
+        if (dev->spiEngine == NULL)
+        {
+            Gpio_config(dev->sclkPin,GPIO_PINS_OUTPUT);
+            Gpio_config(dev->sdinPin,GPIO_PINS_OUTPUT);
+            Gpio_clear(dev->sclkPin);
+
+            dev->spiEngine = &SSD1325Z2_gpioSpiEngine;
+            dev->spiContext = dev;
+        }
+        dev->busOps = &SSD1325Z2_spiBusOps;
+        dev->bus = dev;
+
+#endif
+    }
+
+    // The setup is sent by SSD1325Z2_initPoll, after the power-up delay
+    SSD1325Z2_sendCommand(dev,SSD1325Z2_CMD_DISPLAYON);
+    dev->initTime = now;
+    dev->isReady = FALSE;
+    SSD1325Z2_END(dev,SSD1325Z2_OPERATION_INIT);
+}
+
+bool SSD1325Z2_initPoll (SSD1325Z2_DeviceHandle dev, uint32_t now)
+{
+    if (dev->isReady)
+        return TRUE;
+
+    if ((uint32_t)(now - dev->initTime) < WARCOMEB_SSD1325Z2_POWERUP_DELAY)
+        return FALSE;
+
+    SSD1325Z2_BEGIN(dev,SSD1325Z2_OPERATION_INIT);
+    const SSD1325Z2_InitTable* table = &SSD1325Z2_initDefault;
+    for (uint8_t i = 0; i < sizeof(SSD1325Z2_initTables)/sizeof(SSD1325Z2_initTables[0]); i++)
+    {
+        if (SSD1325Z2_initTables[i].product == dev->gdl.product)
+        {
+            table = &SSD1325Z2_initTables[i];
+            break;
+        }
+    }
+    SSD1325Z2_sendCommandBlock(dev,table->commands,table->length);
+    dev->isReady = TRUE;
+    SSD1325Z2_END(dev,SSD1325Z2_OPERATION_INIT);
+    return TRUE;
+}
+
+#if defined WARCOMEB_GDL_PARALLEL | defined WARCOMEB_GDL_I2C | defined WARCOMEB_GDL_SPI
+/**
+ * The function completes the initialization, waiting the power-up delay.
+ *
+ * @param[in] dev The handle of the device
+ */
+static void SSD1325Z2_initWait (SSD1325Z2_DeviceHandle dev)
+{
+    dev->gdl.delayTime(WARCOMEB_SSD1325Z2_POWERUP_DELAY);
+    SSD1325Z2_initPoll(dev,dev->initTime + WARCOMEB_SSD1325Z2_POWERUP_DELAY);
+}
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_EXTERNAL_BUFFER
+GDL_Errors SSD1325Z2_initWithBufferStart (SSD1325Z2_DeviceHandle dev,
+                                          uint8_t width,
+                                          uint8_t height,
+                                          uint8_t* buffer,
+                                          const SSD1325Z2_BusOps* busOps,
+                                          void* bus,
+                                          uint32_t now)
+{
+    if ((buffer == NULL) || (width % 2) ||
+        (width < 16) || (width > 128) || (height < 16) || (height > 80))
+        return GDL_ERRORS_WRONG_VALUE;
+
+    // Save display size
+    dev->gdl.height = height;
+    dev->gdl.width = width;
+
+#if defined WARCOMEB_SSD1325Z2_USE_FRAMES
+    for (uint8_t i = 0; i < SSD1325Z2_FRAMES; i++)
+        dev->frames[i] = buffer + i * SSD1325Z2_BUFFER_SIZE(dev);
+#else
+    dev->buffer = buffer;
+#endif
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+    dev->shadow = buffer + SSD1325Z2_FRAMES * SSD1325Z2_BUFFER_SIZE(dev);
+#endif
+
+    SSD1325Z2_initDevice(dev,busOps,bus,now);
+    return GDL_ERRORS_OK;
+}
+
+#if defined WARCOMEB_GDL_PARALLEL | defined WARCOMEB_GDL_I2C | defined WARCOMEB_GDL_SPI
+GDL_Errors SSD1325Z2_initWithBuffer (SSD1325Z2_DeviceHandle dev,
+                                     uint8_t width,
+                                     uint8_t height,
+                                     uint8_t* buffer)
+{
+    GDL_Errors error = SSD1325Z2_initWithBufferStart(dev,width,height,buffer,NULL,NULL,0);
+    if (error == GDL_ERRORS_OK)
+        SSD1325Z2_initWait(dev);
+    return error;
+}
+#endif
+#endif
+
+#if defined SSD1325Z2_FIXED_SIZE
+void SSD1325Z2_initStart (SSD1325Z2_DeviceHandle dev,
+                          const SSD1325Z2_BusOps* busOps,
+                          void* bus,
+                          uint32_t now)
+{
+#if defined WARCOMEB_SSD1325Z2_USE_EXTERNAL_BUFFER
+    // The buffer into the device is split like an external one, and its
+    // size is always valid
+    SSD1325Z2_initWithBufferStart(dev,WARCOMEB_SSD1325Z2_WIDTH,WARCOMEB_SSD1325Z2_HEIGHT,
+                                  dev->bufferData,busOps,bus,now);
+#else
+    // Save display size
+    dev->gdl.height = WARCOMEB_SSD1325Z2_HEIGHT;
+    dev->gdl.width = WARCOMEB_SSD1325Z2_WIDTH;
+
+#if defined WARCOMEB_SSD1325Z2_USE_FRAMES
+    for (uint8_t i = 0; i < SSD1325Z2_FRAMES; i++)
+        dev->frames[i] = dev->frameData[i];
+#endif
+
+    SSD1325Z2_initDevice(dev,busOps,bus,now);
+#endif
+}
+
+#if defined WARCOMEB_GDL_PARALLEL | defined WARCOMEB_GDL_I2C | defined WARCOMEB_GDL_SPI
+void SSD1325Z2_init (SSD1325Z2_DeviceHandle dev)
+{
+    SSD1325Z2_initStart(dev,NULL,NULL,0);
+    SSD1325Z2_initWait(dev);
+}
+#endif
+#endif
+
+#if defined WARCOMEB_GDL_PARALLEL
+GDL_Errors SSD1325Z2_setParallelPort (SSD1325Z2_DeviceHandle dev,
+                                      const SSD1325Z2_ParallelPort* port)
+{
+    if ((port == NULL) || (port->setRegister == NULL))
+        return GDL_ERRORS_WRONG_VALUE;
+
+    SSD1325Z2_ParallelPort config = *port;
+    SSD1325Z2_configPort(&config);
+
+    // With a single register, the pins to clear are written into its upper
+    // half-word, so every data pin must be into the lower one
+    if ((config.mask == 0) ||
+        ((config.clearRegister == NULL) && ((config.mask & 0xFFFF0000ul) != 0)))
+        return GDL_ERRORS_WRONG_VALUE;
+
+    SSD1325Z2_waitBus(dev);
+    dev->port = config;
+    dev->busOps = &SSD1325Z2_portBusOps;
+    dev->bus = dev;
+    return GDL_ERRORS_OK;
+}
+#endif
+
+GDL_Errors SSD1325Z2_drawPixel (SSD1325Z2_DeviceHandle dev,
+                                uint8_t xPos,
+                                uint8_t yPos,
+							    SSD1325Z2_GrayScale color)
+{
+    SSD1325Z2_REJECT_RECORDING(dev,GDL_ERRORS_WRONG_VALUE);
+
+    if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
+    {
+        SSD1325Z2_COUNT(dev,rejectedPixels,1);
+        return GDL_ERRORS_WRONG_POSITION;
+    }
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+    // Rows outside of the current band are skipped
+    if ((yPos < dev->bandStart) || (yPos > dev->bandStop))
+        return GDL_ERRORS_OK;
+#endif
+    SSD1325Z2_COUNT(dev,pixels,1);
+
+    uint16_t pos = ((uint16_t) xPos/2) + SSD1325Z2_rowOffset(dev,yPos);
+
+    if (xPos%2)
+        dev->buffer[pos] = ((color & 0x0F) | (dev->buffer[pos] & 0xF0));
+    else
+        dev->buffer[pos] = (((color << 4) & 0xF0) | (dev->buffer[pos] & 0x0F));
+
+    SSD1325Z2_markDirty(dev,xPos,xPos,yPos,yPos);
+
+    return GDL_ERRORS_OK;
+}
+
+/**
+ * The function stops the incremental flush, if it is running: the rest of
+ * the buffer is going to be sent by another flush.
+ *
+ * @param[in] dev The handle of the device
+ */
+static void SSD1325Z2_stopStepping (SSD1325Z2_DeviceHandle dev)
+{
+    if (dev->isStepping)
+    {
+        dev->isStepping = FALSE;
+        SSD1325Z2_END(dev,SSD1325Z2_OPERATION_FLUSHSTEP);
+    }
+}
+
+/**
+ * The function sends all the buffer to the display. It is the body of the
+ * flush, without the statistics, so it can be used for every band.
+ *
+ * @param[in] dev The handle of the device
+ */
+static void SSD1325Z2_sendBuffer (SSD1325Z2_DeviceHandle dev)
+{
+    SSD1325Z2_stopStepping(dev);
+
+    // Print all the buffer
+    SSD1325Z2_sendWindow(dev,0,dev->gdl.width-1,SSD1325Z2_BUFFER_TOP(dev),SSD1325Z2_BUFFER_BOTTOM(dev));
+    // All the buffer is now on the display
+    dev->dirtyCount = 0;
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+    dev->isShadowValid = TRUE;
+#endif
+}
+
+void SSD1325Z2_flush (SSD1325Z2_DeviceHandle dev)
+{
+    SSD1325Z2_BEGIN(dev,SSD1325Z2_OPERATION_FLUSH);
+    SSD1325Z2_COUNT(dev,flushes,1);
+
+    SSD1325Z2_sendBuffer(dev);
+
+    SSD1325Z2_END(dev,SSD1325Z2_OPERATION_FLUSH);
+}
+
+/**
+ * The function ends the asynchronous flush, it is called by the bus.
+ */
+static void SSD1325Z2_flushAsyncDone (void* argument)
+{
+    SSD1325Z2_DeviceHandle dev = (SSD1325Z2_DeviceHandle)argument;
+
+    dev->isFlushing = FALSE;
+    SSD1325Z2_END(dev,SSD1325Z2_OPERATION_FLUSHASYNC);
+    if (dev->flushCallback != NULL)
+        dev->flushCallback(dev);
+}
+
+/**
+ * The function starts to send a whole frame asynchronously.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] data The frame to send, with the layout of the buffer
+ * @param[in] callback The function called at the end of the transfer, or NULL
+ */
+static void SSD1325Z2_sendFrameAsync (SSD1325Z2_DeviceHandle dev,
+                                      const uint8_t* data,
+                                      void (*callback)(SSD1325Z2_DeviceHandle dev))
+{
+    uint8_t yStart = SSD1325Z2_BUFFER_TOP(dev);
+    uint8_t yStop = SSD1325Z2_partStop(dev,yStart,SSD1325Z2_BUFFER_BOTTOM(dev));
+
+    // When the display RAM or the ring of the buffer wraps, the parts before
+    // the last one are sent now
+    while (yStop < SSD1325Z2_BUFFER_BOTTOM(dev))
+    {
+        SSD1325Z2_setBufferPosition(dev,0,dev->gdl.width-1,yStart,yStop);
+        SSD1325Z2_sendDataBlock(dev,&data[SSD1325Z2_rowOffset(dev,yStart)],
+                                (uint16_t)(yStop - yStart + 1) * SSD1325Z2_STRIDE(dev));
+        yStart = yStop + 1;
+        yStop = SSD1325Z2_partStop(dev,yStart,SSD1325Z2_BUFFER_BOTTOM(dev));
+    }
+
+    SSD1325Z2_setBufferPosition(dev,0,dev->gdl.width-1,yStart,yStop);
+    uint16_t size = (uint16_t)(yStop - yStart + 1) * SSD1325Z2_STRIDE(dev);
+    data += SSD1325Z2_rowOffset(dev,yStart);
+
+    dev->flushCallback = callback;
+    dev->isFlushing = TRUE;
+    SSD1325Z2_COUNT(dev,dataBytes,size);
+    if (dev->busOps->writeDataBlockAsync != NULL)
+    {
+        dev->busOps->writeDataBlockAsync(dev->bus,data,size,SSD1325Z2_flushAsyncDone,dev);
+    }
+    else
+    {
+        dev->busOps->writeDataBlock(dev->bus,data,size);
+        SSD1325Z2_flushAsyncDone(dev);
+    }
+}
+
+GDL_Errors SSD1325Z2_flushAsync (SSD1325Z2_DeviceHandle dev,
+                                 void (*callback)(SSD1325Z2_DeviceHandle dev))
+{
+    if (dev->isFlushing) return GDL_ERRORS_WRONG_VALUE;
+    SSD1325Z2_BEGIN(dev,SSD1325Z2_OPERATION_FLUSHASYNC);
+    SSD1325Z2_COUNT(dev,flushes,1);
+
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+    // Send a copy, so the buffer is free for the next frame
+    memcpy(dev->shadow, dev->buffer, SSD1325Z2_BUFFER_SIZE(dev));
+    dev->isShadowValid = TRUE;
+    const uint8_t* data = dev->shadow;
+#else
+    const uint8_t* data = dev->buffer;
+#endif
+    dev->dirtyCount = 0;
+    SSD1325Z2_stopStepping(dev);
+
+    SSD1325Z2_sendFrameAsync(dev,data,callback);
+    return GDL_ERRORS_OK;
+}
+
+#if defined WARCOMEB_SSD1325Z2_USE_FRAMES
+void SSD1325Z2_present (SSD1325Z2_DeviceHandle dev)
+{
+    const uint8_t* frame = dev->buffer;
+
+    // The render frame becomes the newest, and the previous newest frame is
+    // taken back: if it has not been displayed, it is dropped
+    uint8_t ready = WARCOMEB_SSD1325Z2_ATOMIC_EXCHANGE(&dev->frameReady,
+                                                       dev->frameRender | SSD1325Z2_FRAME_FRESH);
+    dev->frameRender = ready & SSD1325Z2_FRAME_INDEX;
+    dev->buffer = dev->frames[dev->frameRender];
+
+    // The drawing continues from the presented content
+    memcpy(dev->buffer, frame, SSD1325Z2_BUFFER_SIZE(dev));
+    dev->dirtyCount = 0;
+}
+
+bool SSD1325Z2_flushFrame (SSD1325Z2_DeviceHandle dev,
+                           void (*callback)(SSD1325Z2_DeviceHandle dev))
+{
+    // Only the present sets the flag, so it can't be lost after this check
+    if (dev->isFlushing || !(dev->frameReady & SSD1325Z2_FRAME_FRESH))
+        return FALSE;
+    SSD1325Z2_BEGIN(dev,SSD1325Z2_OPERATION_FLUSHASYNC);
+    SSD1325Z2_COUNT(dev,flushes,1);
+
+    // The newest frame is taken, the displayed one goes back to the present
+    uint8_t ready = WARCOMEB_SSD1325Z2_ATOMIC_EXCHANGE(&dev->frameReady,dev->frameDisplay);
+    dev->frameDisplay = ready & SSD1325Z2_FRAME_INDEX;
+
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+    dev->isShadowValid = FALSE;
+#endif
+    SSD1325Z2_sendFrameAsync(dev,dev->frames[dev->frameDisplay],callback);
+    return TRUE;
+}
+#endif
+
+bool SSD1325Z2_isFlushing (SSD1325Z2_DeviceHandle dev)
+{
+    return dev->isFlushing;
+}
+
+void SSD1325Z2_flushBegin (SSD1325Z2_DeviceHandle dev)
+{
+    // A restart ends the previous incremental flush
+    SSD1325Z2_stopStepping(dev);
+    SSD1325Z2_BEGIN(dev,SSD1325Z2_OPERATION_FLUSHSTEP);
+    SSD1325Z2_COUNT(dev,flushes,1);
+
+    // All the buffer is going to be sent
+    dev->dirtyCount = 0;
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+    dev->isShadowValid = FALSE;
+#endif
+
+    dev->stepPosition = 0;
+    dev->isStepWindow = FALSE;
+    dev->isStepping = TRUE;
+}
+
+bool SSD1325Z2_flushStep (SSD1325Z2_DeviceHandle dev, uint16_t maxBytes)
+{
+    if (!dev->isStepping) return TRUE;
+
+    uint8_t widthHalf = SSD1325Z2_STRIDE(dev);
+    uint16_t size = (uint16_t)(SSD1325Z2_BUFFER_BOTTOM(dev) - SSD1325Z2_BUFFER_TOP(dev) + 1) * widthHalf;
+
+    while ((maxBytes > 0) && (dev->stepPosition < size))
+    {
+        if (!dev->isStepWindow)
+        {
+            // The window starts from the beginning of the current row, and
+            // it stops at the end of the display RAM or of the ring
+            dev->stepPosition -= dev->stepPosition % widthHalf;
+
+            uint8_t row = SSD1325Z2_BUFFER_TOP(dev) + dev->stepPosition / widthHalf;
+            uint8_t stop = SSD1325Z2_partStop(dev,row,SSD1325Z2_BUFFER_BOTTOM(dev));
+
+            SSD1325Z2_setBufferPosition(dev,0,dev->gdl.width-1,row,stop);
+            dev->stepWindowEnd = (uint16_t)(stop - SSD1325Z2_BUFFER_TOP(dev) + 1) * widthHalf;
+            dev->isStepWindow = TRUE;
+        }
+
+        uint16_t length = dev->stepWindowEnd - dev->stepPosition;
+        if (length > maxBytes) length = maxBytes;
+
+        // The window does not wrap, so its bytes are consecutive
+        uint16_t start = SSD1325Z2_rowOffset(dev,SSD1325Z2_BUFFER_TOP(dev) + dev->stepPosition / widthHalf) +
+                         dev->stepPosition % widthHalf;
+        SSD1325Z2_sendDataBlock(dev,&dev->buffer[start],length);
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+        memcpy(&dev->shadow[start],&dev->buffer[start],length);
+#endif
+        dev->stepPosition += length;
+        maxBytes -= length;
+
+        if (dev->stepPosition == dev->stepWindowEnd)
+            dev->isStepWindow = FALSE;
+    }
+
+    if (dev->stepPosition < size) return FALSE;
+
+    SSD1325Z2_stopStepping(dev);
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+    dev->isShadowValid = TRUE;
+#endif
+    return TRUE;
+}
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+void SSD1325Z2_renderBands (SSD1325Z2_DeviceHandle dev,
+                            void (*draw)(SSD1325Z2_DeviceHandle dev, void* argument),
+                            void* argument)
+{
+    // The bands are one frame
+    SSD1325Z2_BEGIN(dev,SSD1325Z2_OPERATION_RENDERBANDS);
+    SSD1325Z2_COUNT(dev,flushes,1);
+
+    for (uint16_t top = 0; top < dev->gdl.height; top += WARCOMEB_SSD1325Z2_BAND_ROWS)
+    {
+        // The bus could still send the previous band
+        SSD1325Z2_waitBus(dev);
+
+        // The last band can be shorter
+        dev->bandStart = top;
+        dev->bandStop = (top + WARCOMEB_SSD1325Z2_BAND_ROWS > dev->gdl.height) ?
+                        (dev->gdl.height - 1) : (top + WARCOMEB_SSD1325Z2_BAND_ROWS - 1);
+
+        memset(dev->buffer, 0x00, SSD1325Z2_BUFFER_SIZE(dev));
+        dev->dirtyCount = 0;
+
+        if (draw != NULL) draw(dev,argument);
+        SSD1325Z2_sendBuffer(dev);
+    }
+
+    SSD1325Z2_END(dev,SSD1325Z2_OPERATION_RENDERBANDS);
+}
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+
+typedef enum _SSD1325Z2_ListType
+{
+    SSD1325Z2_LISTTYPE_DROPPED,
+    SSD1325Z2_LISTTYPE_RECTANGLE,
+    SSD1325Z2_LISTTYPE_LINE,
+    SSD1325Z2_LISTTYPE_STRING,
+    SSD1325Z2_LISTTYPE_PICTURE,
+} SSD1325Z2_ListType;
+
+/**
+ * Header of every operation of the display list, followed by its arguments.
+ * It has bytes only, so it can be read in place.
+ */
+typedef struct _SSD1325Z2_ListOperation
+{
+    uint8_t type;
+    uint8_t length;             /**< Bytes of the operation, with the header */
+    bool isOpaque;       /**< TRUE when it writes every pixel of its bounds */
+    SSD1325Z2_Rect bounds;     /**< Pixels that can change, into the display */
+} SSD1325Z2_ListOperation;
+
+typedef struct _SSD1325Z2_ListRectangle
+{
+    uint16_t width;
+    uint16_t height;
+    uint8_t xStart;
+    uint8_t yStart;
+    uint8_t color;
+    bool isFill;
+} SSD1325Z2_ListRectangle;
+
+typedef struct _SSD1325Z2_ListLine
+{
+    uint8_t xStart;
+    uint8_t yStart;
+    uint8_t xStop;
+    uint8_t yStop;
+    uint8_t color;
+} SSD1325Z2_ListLine;
+
+typedef struct _SSD1325Z2_ListString
+{
+    uint16_t xPos;
+    uint16_t yPos;
+    uint8_t color;
+    uint8_t background;
+    uint8_t size;
+    /* Followed by the chars and the terminator */
+} SSD1325Z2_ListString;
+
+typedef struct _SSD1325Z2_ListPicture
+{
+    const uint8_t* picture;
+    uint16_t xPos;
+    uint16_t yPos;
+    uint16_t width;
+    uint16_t height;
+    uint8_t pixelType;
+} SSD1325Z2_ListPicture;
+
+static void SSD1325Z2_drawList (SSD1325Z2_DeviceHandle dev, void* argument);
+
+/**
+ * The function appends an operation to the display list. The arguments are
+ * copied, so they don't need any alignment into the list.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] type The type of the operation
+ * @param[in] isOpaque TRUE when it writes every pixel of its bounds
+ * @param[in] xStart The x start of the bounds, clipped to the display
+ * @param[in] xStop The x stop of the bounds, clipped to the display
+ * @param[in] yStart The y start of the bounds, clipped to the display
+ * @param[in] yStop The y stop of the bounds, clipped to the display
+ * @param[in] arguments The arguments of the operation
+ * @param[in] size The bytes of the arguments
+ * @param[in] text The chars appended after the arguments, it can be NULL
+ * @param[in] textLength The number of chars
+ */
+static void SSD1325Z2_record (SSD1325Z2_DeviceHandle dev,
+                              SSD1325Z2_ListType type,
+                              bool isOpaque,
+                              uint8_t xStart,
+                              uint8_t xStop,
+                              uint8_t yStart,
+                              uint8_t yStop,
+                              const void* arguments,
+                              uint8_t size,
+                              const uint8_t* text,
+                              uint8_t textLength)
+{
+    uint16_t length = sizeof(SSD1325Z2_ListOperation) + size + ((text != NULL) ? (textLength + 1) : 0);
+
+    if (dev->listLength + length > WARCOMEB_SSD1325Z2_DISPLAYLIST_BYTES)
+    {
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+        // The bands are drawn from scratch, so nothing can be drawn before
+        dev->isListLost = TRUE;
+        return;
+#else
+        // The full list is drawn into the buffer, and sent at the commit
+        SSD1325Z2_drawList(dev,NULL);
+        dev->listLength = 0;
+#endif
+    }
+
+    SSD1325Z2_ListOperation* operation = (SSD1325Z2_ListOperation*)&dev->list[dev->listLength];
+    operation->type = type;
+    operation->length = (uint8_t)length;
+    operation->isOpaque = isOpaque;
+    operation->bounds.xStart = xStart;
+    operation->bounds.xStop = xStop;
+    operation->bounds.yStart = yStart;
+    operation->bounds.yStop = yStop;
+
+    uint8_t* data = &dev->list[dev->listLength + sizeof(SSD1325Z2_ListOperation)];
+    memcpy(data,arguments,size);
+    if (text != NULL)
+    {
+        memcpy(data + size,text,textLength);
+        data[size + textLength] = '\0';
+    }
+    dev->listLength += length;
+}
+
+/**
+ * The function drops the operations of the list completely covered by a
+ * following opaque one.
+ */
+static void SSD1325Z2_cullList (SSD1325Z2_DeviceHandle dev)
+{
+    for (uint16_t i = 0; i < dev->listLength; i += dev->list[i + 1])
+    {
+        SSD1325Z2_ListOperation* operation = (SSD1325Z2_ListOperation*)&dev->list[i];
+        const SSD1325Z2_Rect* bounds = &operation->bounds;
+
+        for (uint16_t j = i + operation->length; j < dev->listLength; j += dev->list[j + 1])
+        {
+            const SSD1325Z2_ListOperation* cover = (const SSD1325Z2_ListOperation*)&dev->list[j];
+            if (cover->isOpaque && (cover->type != SSD1325Z2_LISTTYPE_DROPPED) &&
+                (cover->bounds.xStart <= bounds->xStart) && (cover->bounds.xStop >= bounds->xStop) &&
+                (cover->bounds.yStart <= bounds->yStart) && (cover->bounds.yStop >= bounds->yStop))
+            {
+                operation->type = SSD1325Z2_LISTTYPE_DROPPED;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * The function draws the operations of the list on the rows into the
+ * buffer, in the recorded order.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] argument Not used, for SSD1325Z2_renderBands
+ */
+static void SSD1325Z2_drawList (SSD1325Z2_DeviceHandle dev, void* argument)
+{
+    (void)argument;
+
+    // The drawing functions must draw now
+    dev->isRecording = FALSE;
+
+    for (uint16_t i = 0; i < dev->listLength; i += dev->list[i + 1])
+    {
+        const SSD1325Z2_ListOperation* operation = (const SSD1325Z2_ListOperation*)&dev->list[i];
+        const uint8_t* data = &dev->list[i + sizeof(SSD1325Z2_ListOperation)];
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+        // Only the operations on the rows of the current band
+        if ((operation->bounds.yStop < dev->bandStart) ||
+            (operation->bounds.yStart > dev->bandStop))
+            continue;
+#endif
+
+        switch (operation->type)
+        {
+        case SSD1325Z2_LISTTYPE_RECTANGLE:
+        {
+            SSD1325Z2_ListRectangle rectangle;
+            memcpy(&rectangle,data,sizeof(rectangle));
+            SSD1325Z2_drawRectangle(dev,rectangle.xStart,rectangle.yStart,rectangle.width,rectangle.height,
+                                    (SSD1325Z2_GrayScale)rectangle.color,rectangle.isFill);
+            break;
+        }
+        case SSD1325Z2_LISTTYPE_LINE:
+        {
+            SSD1325Z2_ListLine line;
+            memcpy(&line,data,sizeof(line));
+            SSD1325Z2_drawLine(dev,line.xStart,line.yStart,line.xStop,line.yStop,
+                               (SSD1325Z2_GrayScale)line.color);
+            break;
+        }
+        case SSD1325Z2_LISTTYPE_STRING:
+        {
+            SSD1325Z2_ListString string;
+            memcpy(&string,data,sizeof(string));
+            SSD1325Z2_drawString(dev,string.xPos,string.yPos,data + sizeof(string),
+                                 (SSD1325Z2_GrayScale)string.color,
+                                 (SSD1325Z2_GrayScale)string.background,string.size);
+            break;
+        }
+        case SSD1325Z2_LISTTYPE_PICTURE:
+        {
+            SSD1325Z2_ListPicture picture;
+            memcpy(&picture,data,sizeof(picture));
+            SSD1325Z2_drawPicture(dev,picture.xPos,picture.yPos,picture.width,picture.height,
+                                  picture.picture,(GDL_PictureType)picture.pixelType);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    dev->isRecording = TRUE;
+}
+
+void SSD1325Z2_beginList (SSD1325Z2_DeviceHandle dev)
+{
+    dev->listLength = 0;
+    dev->isListLost = FALSE;
+    dev->isRecording = TRUE;
+}
+
+GDL_Errors SSD1325Z2_commitList (SSD1325Z2_DeviceHandle dev)
+{
+    SSD1325Z2_cullList(dev);
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+    SSD1325Z2_renderBands(dev,SSD1325Z2_drawList,NULL);
+#else
+    SSD1325Z2_drawList(dev,NULL);
+    SSD1325Z2_flushDirty(dev);
+#endif
+
+    dev->isRecording = FALSE;
+    dev->listLength = 0;
+    return dev->isListLost ? GDL_ERRORS_WRONG_VALUE : GDL_ERRORS_OK;
+}
+
+#endif
+
+/**
+ * The function sends a window of the buffer, and removes the dirty areas
+ * completely into it. It is the body of @ref SSD1325Z2_flushPart, without
+ * the statistics, so the scroll can use it.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The x start position, included
+ * @param[in] xStop The x stop position, included
+ * @param[in] yStart The y start position, included
+ * @param[in] yStop The y stop position, included
+ */
+static void SSD1325Z2_sendPart (SSD1325Z2_DeviceHandle dev,
+                                uint8_t xStart,
+                                uint8_t xStop,
+                                uint8_t yStart,
+                                uint8_t yStop)
+{
+    GDL_Errors error = SSD1325Z2_sendWindow(dev,xStart,xStop,yStart,yStop);
+    if (error == GDL_ERRORS_OK)
+    {
+        // Remove the dirty areas completely sent with this window
+        uint8_t j = 0;
+        for (uint8_t i = 0; i < dev->dirtyCount; i++)
+        {
+            SSD1325Z2_Rect* rect = &dev->dirty[i];
+            if ((rect->xStart >= xStart) && (rect->xStop <= xStop) &&
+                (rect->yStart >= yStart) && (rect->yStop <= yStop))
+                continue;
+            dev->dirty[j++] = *rect;
+        }
+        dev->dirtyCount = j;
+    }
+}
+
+void SSD1325Z2_flushPart (SSD1325Z2_DeviceHandle dev,
+                          uint8_t xStart,
+                          uint8_t xStop,
+                          uint8_t yStart,
+                          uint8_t yStop)
+{
+    SSD1325Z2_BEGIN(dev,SSD1325Z2_OPERATION_FLUSHPART);
+    SSD1325Z2_COUNT(dev,flushes,1);
+
+    SSD1325Z2_sendPart(dev,xStart,xStop,yStart,yStop);
+
+    SSD1325Z2_END(dev,SSD1325Z2_OPERATION_FLUSHPART);
+}
+
+/**
+ * The function sends the dirty areas of the buffer. It is the body of
+ * @ref SSD1325Z2_flushDirty, without the statistics, so the scroll can use it.
+ *
+ * @param[in] dev The handle of the device
+ */
+static void SSD1325Z2_sendDirty (SSD1325Z2_DeviceHandle dev)
+{
+    for (uint8_t i = 0; i < dev->dirtyCount; i++)
+    {
+        SSD1325Z2_Rect* rect = &dev->dirty[i];
+        SSD1325Z2_sendWindow(dev,rect->xStart,rect->xStop,rect->yStart,rect->yStop);
+    }
+    dev->dirtyCount = 0;
+}
+
+void SSD1325Z2_flushDirty (SSD1325Z2_DeviceHandle dev)
+{
+    SSD1325Z2_BEGIN(dev,SSD1325Z2_OPERATION_FLUSHDIRTY);
+    SSD1325Z2_COUNT(dev,flushes,1);
+
+    SSD1325Z2_sendDirty(dev);
+
+    SSD1325Z2_END(dev,SSD1325Z2_OPERATION_FLUSHDIRTY);
+}
+
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+void SSD1325Z2_flushChanges (SSD1325Z2_DeviceHandle dev)
+{
+    if (!dev->isShadowValid)
+    {
+        SSD1325Z2_flush(dev);
+        return;
+    }
+
+    SSD1325Z2_BEGIN(dev,SSD1325Z2_OPERATION_FLUSHCHANGES);
+    SSD1325Z2_COUNT(dev,flushes,1);
+
+    uint8_t widthHalf = SSD1325Z2_STRIDE(dev);
+    bool isOpen = FALSE;
+    // Current window, in columns and rows of the display
+    uint8_t columnStart = 0, columnStop = 0, rowStart = 0, rowStop = 0;
+
+    for (uint8_t i = 0; i < dev->gdl.height; i++)
+    {
+        const uint8_t* row = &dev->buffer[SSD1325Z2_rowOffset(dev,i)];
+        const uint8_t* sent = &dev->shadow[SSD1325Z2_rowOffset(dev,i)];
+
+        // Search the changed span of the row
+        uint8_t first = 0;
+        while ((first < widthHalf) && (row[first] == sent[first])) first++;
+        if (first == widthHalf) continue;
+
+        uint8_t last = widthHalf - 1;
+        while (row[last] == sent[last]) last--;
+
+        if (isOpen)
+        {
+            uint8_t mergedStart = (first < columnStart) ? first : columnStart;
+            uint8_t mergedStop = (last > columnStop) ? last : columnStop;
+            uint16_t merged = (uint16_t)(i - rowStart + 1) * (mergedStop - mergedStart + 1);
+            uint16_t separated = (uint16_t)(rowStop - rowStart + 1) * (columnStop - columnStart + 1) +
+                                 SSD1325Z2_WINDOW_COMMAND_BYTES + (last - first + 1);
+
+            if (merged <= separated)
+            {
+                columnStart = mergedStart;
+                columnStop = mergedStop;
+                rowStop = i;
+                continue;
+            }
+            SSD1325Z2_sendWindow(dev,columnStart*2,columnStop*2+1,rowStart,rowStop);
+        }
+
+        isOpen = TRUE;
+        columnStart = first;
+        columnStop = last;
+        rowStart = i;
+        rowStop = i;
+    }
+
+    if (isOpen)
+        SSD1325Z2_sendWindow(dev,columnStart*2,columnStop*2+1,rowStart,rowStop);
+
+    // Unchanged bytes are equal, so all the buffer is now on the display
+    dev->dirtyCount = 0;
+
+    SSD1325Z2_END(dev,SSD1325Z2_OPERATION_FLUSHCHANGES);
+}
+#endif
+
+void SSD1325Z2_clear (SSD1325Z2_DeviceHandle dev)
+{
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+    // Recorded like a rectangle over the whole display, that drops all the
+    // operations before
+    if (dev->isRecording)
+    {
+        SSD1325Z2_drawRectangle(dev,0,0,dev->gdl.width,dev->gdl.height,SSD1325Z2_GRAYSCALE_0,TRUE);
+        return;
+    }
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_ACCELERATION
+    if (dev->isAccelerated)
+    {
+        // The controller clears the display, and all the buffer is on it
+        SSD1325Z2_fillColumns(dev,0,SSD1325Z2_STRIDE(dev)-1,0,dev->gdl.height-1,SSD1325Z2_GRAYSCALE_0);
+        dev->dirtyCount = 0;
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+        dev->isShadowValid = TRUE;
+#endif
+        return;
+    }
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+    // Every band is sent empty
+    SSD1325Z2_renderBands(dev,NULL,NULL);
+#else
+    // Reset memory buffer
+    memset(dev->buffer, 0x00, SSD1325Z2_BUFFER_SIZE(dev));
+    // Flush the new buffer
+    SSD1325Z2_flush(dev);
+#endif
+}
+
+uint8_t* SSD1325Z2_getRow (SSD1325Z2_DeviceHandle dev, uint8_t yPos)
+{
+    return &dev->buffer[SSD1325Z2_rowOffset(dev,yPos)];
+}
+
+GDL_Errors SSD1325Z2_moveArea (SSD1325Z2_DeviceHandle dev,
+                               uint8_t xStart,
+                               uint8_t yStart,
+                               uint8_t width,
+                               uint8_t height,
+                               uint8_t xDest,
+                               uint8_t yDest)
+{
+    SSD1325Z2_REJECT_RECORDING(dev,GDL_ERRORS_WRONG_VALUE);
+
+    if ((xStart % 2) || (width % 2) || (xDest % 2))
+        return GDL_ERRORS_WRONG_VALUE;
+    if ((width == 0) || (height == 0))
+        return GDL_ERRORS_OK;
+
+    if (((uint16_t)xStart + width > dev->gdl.width) || ((uint16_t)yStart + height > dev->gdl.height) ||
+        ((uint16_t)xDest + width > dev->gdl.width) || ((uint16_t)yDest + height > dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+    // Both the areas must be into the current band
+    if ((yStart < dev->bandStart) || (yStart + height - 1 > dev->bandStop) ||
+        (yDest < dev->bandStart) || (yDest + height - 1 > dev->bandStop))
+        return GDL_ERRORS_WRONG_POSITION;
+#endif
+
+    uint8_t length = width/2;
+    bool isCopied = FALSE;
+
+#if defined WARCOMEB_SSD1325Z2_USE_ACCELERATION
+    // The copy of the controller can't wrap at the end of the display RAM
+    uint8_t yWrap = SSD1325Z2_RAM_ROWS - dev->startLine;
+    isCopied = dev->isAccelerated &&
+               ((yStart >= yWrap) || (yStart + height <= yWrap)) &&
+               ((yDest >= yWrap) || (yDest + height <= yWrap));
+    if (isCopied)
+    {
+        // The controller copies what it shows, so it must be updated before
+        SSD1325Z2_flushDirtyOver(dev,xStart,xStart+width-1,yStart,yStart+height-1);
+
+        // The area does not wrap, so only the first rows are rotated
+        uint8_t rowStart = (yStart + dev->startLine) % SSD1325Z2_RAM_ROWS;
+        uint8_t rowDest = (yDest + dev->startLine) % SSD1325Z2_RAM_ROWS;
+        const uint8_t commands[] =
+        {
+            SSD1325Z2_CMD_COPY, xStart/2, rowStart, (xStart+width)/2-1, rowStart + height - 1,
+            xDest/2, rowDest,
+        };
+        // The copy reads the source and writes the destination
+        const SSD1325Z2_Rect area =
+        {
+            ((xStart < xDest) ? xStart : xDest)/2,
+            ((xStart < xDest) ? xDest : xStart)/2 + length - 1,
+            (rowStart < rowDest) ? rowStart : rowDest,
+            ((rowStart < rowDest) ? rowDest : rowStart) + height - 1,
+        };
+        SSD1325Z2_sendAcceleration(dev,commands,sizeof(commands),&area);
+    }
+#endif
+
+    // Rows are moved in the order that does not overwrite the source
+    for (uint8_t i = 0; i < height; i++)
+    {
+        uint8_t row = (yDest > yStart) ? (height - 1 - i) : i;
+        uint16_t dest = (xDest/2) + SSD1325Z2_rowOffset(dev,yDest + row);
+        uint16_t source = (xStart/2) + SSD1325Z2_rowOffset(dev,yStart + row);
+        memmove(&dev->buffer[dest],&dev->buffer[source],length);
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+        if (isCopied)
+            memmove(&dev->shadow[dest],&dev->shadow[source],length);
+#endif
+    }
+
+    if (!isCopied)
+        SSD1325Z2_markDirty(dev,xDest,xDest+width-1,yDest,yDest+height-1);
+    return GDL_ERRORS_OK;
+}
+
+#if !defined WARCOMEB_SSD1325Z2_USE_BANDS & !defined WARCOMEB_SSD1325Z2_USE_FRAMES
+
+/**
+ * The function scrolls the buffer up, and moves the start line so the rows at
+ * the bottom use the display RAM just scrolled out. The new rows are filled
+ * with a color, and they still need to be sent before the start line.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] rows The number of rows to scroll
+ * @param[in] color The color of the new rows
+ */
+static void SSD1325Z2_scrollBuffer (SSD1325Z2_DeviceHandle dev,
+                                    uint8_t rows,
+                                    SSD1325Z2_GrayScale color)
+{
+    // Pending changes are sent with the current start line
+    SSD1325Z2_flushStep(dev,0xFFFF);
+    SSD1325Z2_sendDirty(dev);
+    SSD1325Z2_waitBus(dev);
+
+    // The rows scrolled out become the new rows at the bottom, both into
+    // the ring of the buffer and into the display RAM
+    for (uint8_t i = 0; i < rows; i++)
+        memset(&dev->buffer[SSD1325Z2_rowOffset(dev,i)],((color & 0x0F) << 4) | (color & 0x0F),SSD1325Z2_STRIDE(dev));
+
+    dev->ringStart = (dev->ringStart + rows) % dev->gdl.height;
+    dev->startLine = (dev->startLine + rows) % SSD1325Z2_RAM_ROWS;
+}
+
+/**
+ * The function sends the new rows at the bottom of the display, and then
+ * rotates the display with the start line.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] rows The number of rows scrolled
+ */
+static void SSD1325Z2_scrollDisplay (SSD1325Z2_DeviceHandle dev, uint8_t rows)
+{
+    SSD1325Z2_sendPart(dev,0,dev->gdl.width-1,dev->gdl.height-rows,dev->gdl.height-1);
+
+    const uint8_t commands[] = {SSD1325Z2_CMD_STARTLINE, dev->startLine};
+    SSD1325Z2_sendCommandBlock(dev,commands,sizeof(commands));
+}
+
+GDL_Errors SSD1325Z2_scrollUp (SSD1325Z2_DeviceHandle dev,
+                               uint8_t rows,
+                               SSD1325Z2_GrayScale color)
+{
+    SSD1325Z2_REJECT_RECORDING(dev,GDL_ERRORS_WRONG_VALUE);
+
+    if (rows > dev->gdl.height) return GDL_ERRORS_WRONG_VALUE;
+    if (rows == 0) return GDL_ERRORS_OK;
+
+    SSD1325Z2_scrollBuffer(dev,rows,color);
+    SSD1325Z2_scrollDisplay(dev,rows);
+    return GDL_ERRORS_OK;
+}
+
+GDL_Errors SSD1325Z2_printLine (SSD1325Z2_DeviceHandle dev,
+                                const uint8_t* text,
+                                SSD1325Z2_GrayScale color,
+                                SSD1325Z2_GrayScale background,
+                                uint8_t size)
+{
+    SSD1325Z2_REJECT_RECORDING(dev,GDL_ERRORS_WRONG_VALUE);
+
+    if (size == 0) size = dev->gdl.fontSize;
+
+    uint8_t rows = size * GDL_DEFAULT_FONT_HEIGHT;
+    if (rows > dev->gdl.height) return GDL_ERRORS_WRONG_VALUE;
+
+    SSD1325Z2_scrollBuffer(dev,rows,background);
+
+    // Characters beyond the width of the display are not printed
+    uint8_t charWidth = size * GDL_DEFAULT_FONT_WIDTH;
+    uint8_t length = 0;
+    while ((text[length] != '\n') && (text[length] != '\0') &&
+           ((length + 1) * charWidth <= dev->gdl.width))
+    {
+        length++;
+    }
+    for (uint8_t i = 0; i < length; i++)
+        SSD1325Z2_drawChar(dev,charWidth * i,dev->gdl.height-rows,text[i],color,background,size);
+
+    SSD1325Z2_scrollDisplay(dev,rows);
+    return GDL_ERRORS_OK;
+}
+
+#endif
+
+void SSD1325Z2_drawLine (SSD1325Z2_DeviceHandle dev,
+                         uint8_t xStart,
+                         uint8_t yStart,
+                         uint8_t xStop,
+                         uint8_t yStop,
+                         SSD1325Z2_GrayScale color)
+{
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+    if (dev->isRecording)
+    {
+        uint8_t xFirst = (xStart < xStop) ? xStart : xStop;
+        uint8_t xLast = (xStart < xStop) ? xStop : xStart;
+        uint8_t yFirst = (yStart < yStop) ? yStart : yStop;
+        uint8_t yLast = (yStart < yStop) ? yStop : yStart;
+        if ((xFirst >= dev->gdl.width) || (yFirst >= dev->gdl.height)) return;
+        if (xLast >= dev->gdl.width) xLast = dev->gdl.width - 1;
+        if (yLast >= dev->gdl.height) yLast = dev->gdl.height - 1;
+
+        SSD1325Z2_ListLine line = {xStart, yStart, xStop, yStop, color};
+        SSD1325Z2_record(dev,SSD1325Z2_LISTTYPE_LINE,FALSE,xFirst,xLast,yFirst,yLast,
+                         &line,sizeof(line),NULL,0);
+        return;
+    }
+#endif
+    GDL_drawLine(&(dev->gdl),xStart,yStart,xStop,yStop,(uint8_t)color);
+}
+
+/**
+ * The function fills an area of the buffer with a color. The area is clipped
+ * to the rows into the buffer, and the bounds can be outside of it.
+ * Two pixels share the same byte of the buffer: only the edge pixels of the
+ * rows are written by themselves, the inner bytes are filled with memset.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The x start position, included
+ * @param[in] xStop The x stop position, included
+ * @param[in] yStart The y start position, included
+ * @param[in] yStop The y stop position, included
+ * @param[in] color The color of the area
+ */
+static void SSD1325Z2_fillArea (SSD1325Z2_DeviceHandle dev,
+                                int16_t xStart,
+                                int16_t xStop,
+                                int16_t yStart,
+                                int16_t yStop,
+                                SSD1325Z2_GrayScale color)
+{
+    if (xStart < 0) xStart = 0;
+    if (yStart < SSD1325Z2_BUFFER_TOP(dev)) yStart = SSD1325Z2_BUFFER_TOP(dev);
+    if (xStop >= dev->gdl.width) xStop = dev->gdl.width - 1;
+    if (yStop > SSD1325Z2_BUFFER_BOTTOM(dev)) yStop = SSD1325Z2_BUFFER_BOTTOM(dev);
+    if ((xStart > xStop) || (yStart > yStop)) return;
+
+    uint8_t low = color & 0x0F;
+    uint8_t high = low << 4;
+
+    // The pixels written by memset, between the edges
+    int16_t innerStart = (xStart + 1) & ~1;
+    int16_t innerStop = (xStop & 1) ? xStop : (xStop - 1);
+    for (int16_t i = yStart; i <= yStop; i++)
+    {
+        uint8_t* row = &dev->buffer[SSD1325Z2_rowOffset(dev,i)];
+
+        if (xStart & 1)
+            row[xStart/2] = (row[xStart/2] & 0xF0) | low;
+        if (innerStop > innerStart)
+            memset(&row[innerStart/2], high | low, (innerStop - innerStart + 1)/2);
+        if (!(xStop & 1) && (xStop >= innerStart))
+            row[xStop/2] = (row[xStop/2] & 0x0F) | high;
+    }
+
+    SSD1325Z2_markDirty(dev,xStart,xStop,yStart,yStop);
+}
+
+void SSD1325Z2_drawHLine (SSD1325Z2_DeviceHandle dev,
+                          uint8_t xStart,
+                          uint8_t yStart,
+                          uint8_t width,
+                          SSD1325Z2_GrayScale color)
+{
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+    // Recorded like the filled rectangle with the same pixels
+    if (dev->isRecording)
+    {
+        SSD1325Z2_drawRectangle(dev,xStart,yStart,(uint16_t)width + 1,1,color,TRUE);
+        return;
+    }
+#endif
+    SSD1325Z2_fillArea(dev,xStart,(int16_t)xStart + width,yStart,yStart,color);
+}
+
+void SSD1325Z2_drawVLine (SSD1325Z2_DeviceHandle dev,
+                          uint8_t xStart,
+                          uint8_t yStart,
+                          uint8_t height,
+                          SSD1325Z2_GrayScale color)
+{
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+    // Recorded like the filled rectangle with the same pixels
+    if (dev->isRecording)
+    {
+        SSD1325Z2_drawRectangle(dev,xStart,yStart,1,(uint16_t)height + 1,color,TRUE);
+        return;
+    }
+#endif
+    SSD1325Z2_fillArea(dev,xStart,xStart,yStart,(int16_t)yStart + height,color);
+}
+
+void SSD1325Z2_drawRectangle (SSD1325Z2_DeviceHandle dev,
+                              uint16_t xStart,
+                              uint16_t yStart,
+                              uint16_t width,
+                              uint16_t height,
+                              SSD1325Z2_GrayScale color,
+                              bool isFill)
+{
+    if ((width == 0) || (height == 0)) return;
+    if ((xStart >= dev->gdl.width) || (yStart >= dev->gdl.height)) return;
+
+    // Edges outside of the display are not drawn, so the size can be limited
+    int16_t xStop = xStart + ((width > 2*dev->gdl.width) ? 2*dev->gdl.width : width) - 1;
+    int16_t yStop = yStart + ((height > 2*dev->gdl.height) ? 2*dev->gdl.height : height) - 1;
+
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+    if (dev->isRecording)
+    {
+        SSD1325Z2_ListRectangle rectangle = {width, height, xStart, yStart, color, isFill};
+        SSD1325Z2_record(dev,SSD1325Z2_LISTTYPE_RECTANGLE,isFill,xStart,
+                         (xStop >= dev->gdl.width) ? (dev->gdl.width - 1) : xStop,yStart,
+                         (yStop >= dev->gdl.height) ? (dev->gdl.height - 1) : yStop,
+                         &rectangle,sizeof(rectangle),NULL,0);
+        return;
+    }
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_ACCELERATION
+    if (isFill && dev->isAccelerated)
+    {
+        if (xStop >= dev->gdl.width) xStop = dev->gdl.width - 1;
+        if (yStop >= dev->gdl.height) yStop = dev->gdl.height - 1;
+
+        // Columns completely inside the rectangle
+        uint8_t columnStart = (xStart + 1)/2;
+        int16_t columnStop = (xStop + 1)/2 - 1;
+
+        if (columnStart <= columnStop)
+        {
+            SSD1325Z2_fillColumns(dev,columnStart,columnStop,yStart,yStop,color);
+            // Edge pixels that share the column with the outside
+            if (xStart % 2)
+                SSD1325Z2_fillArea(dev,xStart,xStart,yStart,yStop,color);
+            if ((xStop % 2) == 0)
+                SSD1325Z2_fillArea(dev,xStop,xStop,yStart,yStop,color);
+            return;
+        }
+    }
+#endif
+
+    if (isFill)
+    {
+        SSD1325Z2_fillArea(dev,xStart,xStop,yStart,yStop,color);
+    }
+    else
+    {
+        SSD1325Z2_fillArea(dev,xStart,xStop,yStart,yStart,color);
+        SSD1325Z2_fillArea(dev,xStart,xStop,yStop,yStop,color);
+        SSD1325Z2_fillArea(dev,xStart,xStart,yStart,yStop,color);
+        SSD1325Z2_fillArea(dev,xStop,xStop,yStart,yStop,color);
+    }
+}
+
+/**
+ * The function blends a color into a pixel of the buffer, weighted by the
+ * coverage of the pixel. Pixels outside of the buffer are skipped and the
+ * damage is not marked.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xPos The x position
+ * @param[in] yPos The y position
+ * @param[in] color The color
+ * @param[in] coverage The coverage, from 0 (unchanged) to 255 (the color)
+ */
+static inline void SSD1325Z2_blendPixel (SSD1325Z2_DeviceHandle dev,
+                                         int16_t xPos,
+                                         int16_t yPos,
+                                         uint8_t color,
+                                         uint8_t coverage)
+{
+    if ((coverage == 0) || (xPos < 0) || (xPos >= dev->gdl.width) ||
+        (yPos < SSD1325Z2_BUFFER_TOP(dev)) || (yPos > SSD1325Z2_BUFFER_BOTTOM(dev)))
+        return;
+
+    uint8_t* pixel = &dev->buffer[xPos/2 + SSD1325Z2_rowOffset(dev,yPos)];
+    uint8_t shift = (xPos & 1) ? 0 : 4;
+    uint16_t level = (*pixel >> shift) & 0x0F;
+
+    // Rounded division by 255, exact for every value up to 65535
+    level = level * (255 - coverage) + color * coverage + 127;
+    level = (level + 1 + (level >> 8)) >> 8;
+    *pixel = (*pixel & ~(0x0F << shift)) | (level << shift);
+}
+
+/**
+ * The function marks the damage of a shape, clipped to the display.
+ */
+static void SSD1325Z2_markDirtyClipped (SSD1325Z2_DeviceHandle dev,
+                                        int16_t xStart,
+                                        int16_t xStop,
+                                        int16_t yStart,
+                                        int16_t yStop)
+{
+    if (xStart < 0) xStart = 0;
+    if (yStart < 0) yStart = 0;
+    if (xStop >= dev->gdl.width) xStop = dev->gdl.width - 1;
+    if (yStop >= dev->gdl.height) yStop = dev->gdl.height - 1;
+    if ((xStart > xStop) || (yStart > yStop)) return;
+
+    SSD1325Z2_markDirty(dev,xStart,xStop,yStart,yStop);
+}
+
+/**
+ * The function computes the integer square root of a number, rounded down.
+ */
+static uint32_t SSD1325Z2_sqrt (uint32_t value)
+{
+    uint32_t result = 0;
+    uint32_t bit = 1ul << 30;
+
+    while (bit > value)
+        bit >>= 2;
+    while (bit != 0)
+    {
+        if (value >= result + bit)
+        {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+void SSD1325Z2_drawAntialiasedLine (SSD1325Z2_DeviceHandle dev,
+                                    uint8_t xStart,
+                                    uint8_t yStart,
+                                    uint8_t xStop,
+                                    uint8_t yStop,
+                                    SSD1325Z2_GrayScale color)
+{
+    SSD1325Z2_REJECT_RECORDING(dev,);
+
+    int16_t dx = (int16_t)xStop - xStart;
+    int16_t dy = (int16_t)yStop - yStart;
+    bool isSteep = ((dy < 0) ? -dy : dy) > ((dx < 0) ? -dx : dx);
+
+    // Walk along the major axis, with the minor one in 16.16 fixed point
+    int16_t major = isSteep ? yStart : xStart;
+    int16_t majorStop = isSteep ? yStop : xStop;
+    int32_t minor = (int32_t)(isSteep ? xStart : yStart) << 16;
+    int16_t majorDelta = isSteep ? dy : dx;
+    int16_t minorDelta = isSteep ? dx : dy;
+
+    if (majorDelta < 0)
+    {
+        major = majorStop;
+        majorStop = isSteep ? yStart : xStart;
+        minor = (int32_t)(isSteep ? xStop : yStop) << 16;
+        majorDelta = -majorDelta;
+        minorDelta = -minorDelta;
+    }
+
+    int32_t gradient = 0;
+    if (majorDelta != 0)
+        gradient = ((int32_t)minorDelta * 65536 + ((minorDelta < 0) ? -majorDelta : majorDelta)/2) / majorDelta;
+
+    SSD1325Z2_markDirtyClipped(dev,
+                               (xStart < xStop) ? xStart : xStop,(xStart < xStop) ? xStop + 1 : xStart + 1,
+                               (yStart < yStop) ? yStart : yStop,(yStart < yStop) ? yStop + 1 : yStart + 1);
+
+    // Every step covers the two pixels around the line, by the distance
+    for (; major <= majorStop; major++, minor += gradient)
+    {
+        int16_t position = (int16_t)(minor >> 16);
+        uint8_t fraction = (uint8_t)(minor >> 8);
+
+        if (isSteep)
+        {
+            SSD1325Z2_blendPixel(dev,position,major,color,255 - fraction);
+            SSD1325Z2_blendPixel(dev,position + 1,major,color,fraction);
+        }
+        else
+        {
+            SSD1325Z2_blendPixel(dev,major,position,color,255 - fraction);
+            SSD1325Z2_blendPixel(dev,major,position + 1,color,fraction);
+        }
+    }
+}
+
+/**
+ * The function blends a pixel in the four quadrants of a circle.
+ */
+static void SSD1325Z2_blendQuadrants (SSD1325Z2_DeviceHandle dev,
+                                      int16_t xCenter,
+                                      int16_t yCenter,
+                                      int16_t x,
+                                      int16_t y,
+                                      uint8_t color,
+                                      uint8_t coverage)
+{
+    SSD1325Z2_blendPixel(dev,xCenter + x,yCenter + y,color,coverage);
+    if (x != 0)
+        SSD1325Z2_blendPixel(dev,xCenter - x,yCenter + y,color,coverage);
+    if (y != 0)
+        SSD1325Z2_blendPixel(dev,xCenter + x,yCenter - y,color,coverage);
+    if ((x != 0) && (y != 0))
+        SSD1325Z2_blendPixel(dev,xCenter - x,yCenter - y,color,coverage);
+}
+
+void SSD1325Z2_drawAntialiasedCircle (SSD1325Z2_DeviceHandle dev,
+                                      uint8_t xCenter,
+                                      uint8_t yCenter,
+                                      uint8_t radius,
+                                      SSD1325Z2_GrayScale color)
+{
+    SSD1325Z2_REJECT_RECORDING(dev,);
+
+    uint32_t square = (uint32_t)radius * radius;
+
+    SSD1325Z2_markDirtyClipped(dev,(int16_t)xCenter - radius - 1,(int16_t)xCenter + radius + 1,
+                               (int16_t)yCenter - radius - 1,(int16_t)yCenter + radius + 1);
+
+    // One octant is computed, the others are its reflections
+    for (int16_t x = 0; x <= radius; x++)
+    {
+        // Height of the circle in 8.8 fixed point
+        uint32_t height = SSD1325Z2_sqrt((square - (uint32_t)x * x) << 16);
+        int16_t y = (int16_t)(height >> 8);
+        uint8_t fraction = (uint8_t)height;
+
+        if (x > y)
+            break;
+
+        SSD1325Z2_blendQuadrants(dev,xCenter,yCenter,x,y,color,255 - fraction);
+        SSD1325Z2_blendQuadrants(dev,xCenter,yCenter,x,y + 1,color,fraction);
+        if (x != y)
+        {
+            SSD1325Z2_blendQuadrants(dev,xCenter,yCenter,y,x,color,255 - fraction);
+            SSD1325Z2_blendQuadrants(dev,xCenter,yCenter,y + 1,x,color,fraction);
+        }
+    }
+}
+
+void SSD1325Z2_drawThickLine (SSD1325Z2_DeviceHandle dev,
+                              uint8_t xStart,
+                              uint8_t yStart,
+                              uint8_t xStop,
+                              uint8_t yStop,
+                              uint8_t thickness,
+                              SSD1325Z2_GrayScale color)
+{
+    SSD1325Z2_REJECT_RECORDING(dev,);
+
+    if (thickness <= 1)
+    {
+        SSD1325Z2_drawAntialiasedLine(dev,xStart,yStart,xStop,yStop,color);
+        return;
+    }
+
+    int16_t dx = (int16_t)xStop - xStart;
+    int16_t dy = (int16_t)yStop - yStart;
+    // Length in 8.8 fixed point, and its inverse in 16.16
+    uint32_t length = SSD1325Z2_sqrt(((uint32_t)(dx * dx) + (uint32_t)(dy * dy)) << 16);
+    int32_t inverse = (length != 0) ? (int32_t)((1ul << 24) / length) : 0x10000;
+    if (length == 0)
+        dx = 1;
+
+    // Distances from the edges in 16.16 fixed point: half a pixel more
+    // than the shape, so the pixels on the edges are partially covered
+    int32_t side = ((int32_t)thickness << 15) + 0x8000;
+    int32_t end = ((int32_t)length << 8) + 0x8000;
+    int32_t distanceStep = dy * inverse;
+    int32_t projectionStep = dx * inverse;
+
+    int16_t border = thickness/2 + 1;
+    int16_t xFirst = ((xStart < xStop) ? xStart : xStop) - border;
+    int16_t xLast = ((xStart < xStop) ? xStop : xStart) + border;
+    int16_t yFirst = ((yStart < yStop) ? yStart : yStop) - border;
+    int16_t yLast = ((yStart < yStop) ? yStop : yStart) + border;
+    if (xFirst < 0) xFirst = 0;
+    if (xLast >= dev->gdl.width) xLast = dev->gdl.width - 1;
+    if (yFirst < SSD1325Z2_BUFFER_TOP(dev)) yFirst = SSD1325Z2_BUFFER_TOP(dev);
+    if (yLast > SSD1325Z2_BUFFER_BOTTOM(dev)) yLast = SSD1325Z2_BUFFER_BOTTOM(dev);
+
+    SSD1325Z2_markDirtyClipped(dev,xFirst,xLast,yFirst,yLast);
+
+    for (int16_t y = yFirst; y <= yLast; y++)
+    {
+        // Signed distance from the line and position along it, of the
+        // first pixel of the row
+        int32_t distance = ((int32_t)(xFirst - xStart) * dy - (int32_t)(y - yStart) * dx) * inverse;
+        int32_t projection = ((int32_t)(xFirst - xStart) * dx + (int32_t)(y - yStart) * dy) * inverse;
+        int16_t run = -1;
+
+        for (int16_t x = xFirst; x <= xLast; x++, distance += distanceStep, projection += projectionStep)
+        {
+            int32_t coverage = side - ((distance < 0) ? -distance : distance);
+            if (projection + 0x8000 < coverage)
+                coverage = projection + 0x8000;
+            if (end - projection < coverage)
+                coverage = end - projection;
+
+            if (coverage >= 0x10000)
+            {
+                // The inside of the line is filled a run at a time
+                if (run < 0) run = x;
+                continue;
+            }
+            if (run >= 0)
+            {
+                SSD1325Z2_fillArea(dev,run,x - 1,y,y,color);
+                run = -1;
+            }
+            if (coverage > 0)
+                SSD1325Z2_blendPixel(dev,x,y,color,(uint8_t)(coverage >> 8));
+        }
+        if (run >= 0)
+            SSD1325Z2_fillArea(dev,run,xLast,y,y,color);
+    }
+}
+
+/**
+ * The function copies a sequence of pixels between two nibble-packed rows,
+ * where every byte holds two pixels and the left one is the high nibble.
+ * When source and destination have the same parity the inner bytes are
+ * copied with memcpy, otherwise they are shifted by a nibble.
+ *
+ * @param[in] dst The destination row
+ * @param[in] dstX The position of the first destination pixel
+ * @param[in] src The source row
+ * @param[in] srcX The position of the first source pixel
+ * @param[in] count The number of pixels
+ */
+static void SSD1325Z2_copyNibbles (uint8_t* dst,
+                                   uint16_t dstX,
+                                   const uint8_t* src,
+                                   uint16_t srcX,
+                                   uint16_t count)
+{
+    if (count == 0) return;
+
+    dst += dstX/2;
+    src += srcX/2;
+
+    if ((dstX & 1) == (srcX & 1))
+    {
+        if (dstX & 1)
+        {
+            *dst = (*dst & 0xF0) | (*src & 0x0F);
+            dst++;
+            src++;
+            count--;
+        }
+        memcpy(dst,src,count/2);
+        if (count & 1)
+            dst[count/2] = (dst[count/2] & 0x0F) | (src[count/2] & 0xF0);
+        return;
+    }
+
+    if (dstX & 1)
+    {
+        // Source starts with a high nibble
+        *dst = (*dst & 0xF0) | (*src >> 4);
+        dst++;
+        count--;
+        for (; count >= 2; count -= 2, src++)
+            *dst++ = (src[0] << 4) | (src[1] >> 4);
+        if (count)
+            *dst = (*dst & 0x0F) | (src[0] << 4);
+    }
+    else
+    {
+        // Source starts with a low nibble
+        for (; count >= 2; count -= 2, src++)
+            *dst++ = (src[0] << 4) | (src[1] >> 4);
+        if (count)
+            *dst = (*dst & 0x0F) | (src[0] << 4);
+    }
+}
+
+#if (WARCOMEB_SSD1325Z2_GLYPH_CACHE_ENTRIES > 0)
+
+void SSD1325Z2_clearGlyphCache (SSD1325Z2_DeviceHandle dev)
+{
+    for (uint8_t i = 0; i < WARCOMEB_SSD1325Z2_GLYPH_CACHE_ENTRIES; i++)
+        dev->glyphs[i].size = 0;
+}
+
+/**
+ * The function returns the place of a char into the cache: every char has a
+ * fixed place, and replaces the previous owner of it.
+ */
+static inline SSD1325Z2_Glyph* SSD1325Z2_getGlyph (SSD1325Z2_DeviceHandle dev,
+                                                   uint8_t c,
+                                                   uint8_t colors,
+                                                   uint8_t size)
+{
+    return &dev->glyphs[(c + colors * 7 + size * 3) % WARCOMEB_SSD1325Z2_GLYPH_CACHE_ENTRIES];
+}
+
+#endif
+
+GDL_Errors SSD1325Z2_drawChar (SSD1325Z2_DeviceHandle dev,
+                               uint16_t xPos,
+                               uint16_t yPos,
+                               uint8_t c,
+                               SSD1325Z2_GrayScale color,
+                               SSD1325Z2_GrayScale background,
+                               uint8_t size)
+{
+    SSD1325Z2_REJECT_RECORDING(dev,GDL_ERRORS_WRONG_VALUE);
+
+#if (WARCOMEB_SSD1325Z2_GLYPH_CACHE_ENTRIES > 0)
+    if (size == 0) size = dev->gdl.fontSize;
+
+    if (!dev->gdl.useCustomFont && (size <= WARCOMEB_SSD1325Z2_GLYPH_CACHE_MAXSIZE))
+    {
+        uint16_t width = size * GDL_DEFAULT_FONT_WIDTH;
+        uint16_t height = size * GDL_DEFAULT_FONT_HEIGHT;
+
+        if ((xPos + width > dev->gdl.width) || (yPos + height > dev->gdl.height))
+            return GDL_ERRORS_WRONG_POSITION;
+
+        uint8_t colors = ((color & 0x0F) << 4) | (background & 0x0F);
+        SSD1325Z2_Glyph* glyph = SSD1325Z2_getGlyph(dev,c,colors,size);
+        uint8_t glyphHalf = (width + 1)/2;
+
+        // Only the rows into the buffer are drawn
+        int16_t first = SSD1325Z2_BUFFER_TOP(dev) - (int16_t)yPos;
+        int16_t last = SSD1325Z2_BUFFER_BOTTOM(dev) - (int16_t)yPos;
+        if (first < 0) first = 0;
+        if (last >= (int16_t)height) last = height - 1;
+        if (first > last) return GDL_ERRORS_OK;
+
+        if ((glyph->size == size) && (glyph->c == c) && (glyph->colors == colors))
+        {
+            for (int16_t i = first; i <= last; i++)
+            {
+                SSD1325Z2_copyNibbles(&dev->buffer[SSD1325Z2_rowOffset(dev,yPos + i)],xPos,
+                                      &glyph->data[i * glyphHalf],0,width);
+            }
+            SSD1325Z2_markDirty(dev,xPos,xPos + width - 1,yPos + first,yPos + last);
+            return GDL_ERRORS_OK;
+        }
+
+        // GDL draws the char into the buffer, over the background like the
+        // copies, then the glyph is saved from there when it is all inside
+        SSD1325Z2_fillArea(dev,xPos,xPos + width - 1,yPos,yPos + height - 1,background);
+        GDL_Errors error = GDL_drawChar(&(dev->gdl),xPos,yPos,c,(uint8_t)color,(uint8_t)background,size);
+        if ((error == GDL_ERRORS_OK) && (first == 0) && (last == height - 1))
+        {
+            for (uint16_t i = 0; i < height; i++)
+            {
+                SSD1325Z2_copyNibbles(&glyph->data[i * glyphHalf],0,
+                                      &dev->buffer[SSD1325Z2_rowOffset(dev,yPos + i)],xPos,width);
+            }
+            glyph->c = c;
+            glyph->colors = colors;
+            glyph->size = size;
+        }
+        return error;
+    }
+#endif
+    return GDL_drawChar(&(dev->gdl),xPos,yPos,c,(uint8_t)color,(uint8_t)background,size);
+}
+
+GDL_Errors SSD1325Z2_drawString (SSD1325Z2_DeviceHandle dev,
+                                 uint16_t xPos,
+                                 uint16_t yPos,
+                                 const uint8_t* text,
+                                 SSD1325Z2_GrayScale color,
+                                 SSD1325Z2_GrayScale background,
+                                 uint8_t size)
+{
+    if (size == 0) size = dev->gdl.fontSize;
+
+    uint8_t charWidth = size * GDL_DEFAULT_FONT_WIDTH;
+    GDL_Errors error;
+
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+    if (dev->isRecording)
+    {
+        if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
+            return GDL_ERRORS_WRONG_POSITION;
+
+        // The chars after the right side of the display are never drawn
+        uint8_t length = 0;
+        while ((text[length] != '\n') && (text[length] != '\0') &&
+               (xPos + (uint16_t)charWidth * length < dev->gdl.width))
+            length++;
+        if (length == 0) return GDL_ERRORS_OK;
+
+        // The chars start at the same positions with every font, but the
+        // size of a custom font is not known: its bounds go to the edges
+        uint16_t xStop = dev->gdl.useCustomFont ? (dev->gdl.width - 1) :
+                         (xPos + (uint16_t)charWidth * length - 1);
+        uint16_t yStop = dev->gdl.useCustomFont ? (dev->gdl.height - 1) :
+                         (yPos + (uint16_t)size * GDL_DEFAULT_FONT_HEIGHT - 1);
+        if (xStop >= dev->gdl.width) xStop = dev->gdl.width - 1;
+        if (yStop >= dev->gdl.height) yStop = dev->gdl.height - 1;
+
+        SSD1325Z2_ListString string = {xPos, yPos, color, background, size};
+        SSD1325Z2_record(dev,SSD1325Z2_LISTTYPE_STRING,FALSE,xPos,xStop,yPos,yStop,
+                         &string,sizeof(string),text,length);
+        return GDL_ERRORS_OK;
+    }
+#endif
+
+    for (uint8_t i=0; text[i] != '\n' && text[i] != '\0'; i++)
+    {
+        error = SSD1325Z2_drawChar(dev,(xPos + charWidth * i),yPos,text[i],color,background,size);
+        if (error != GDL_ERRORS_OK) return error;
+    }
+    return GDL_ERRORS_OK;
+}
+
+/** Expands the bits of a byte into four bytes of pixels with color 0 or 15 */
+#define SSD1325Z2_EXPAND(b)    {(((b) & 0x80) ? 0xF0 : 0) | (((b) & 0x40) ? 0x0F : 0), \
+                                (((b) & 0x20) ? 0xF0 : 0) | (((b) & 0x10) ? 0x0F : 0), \
+                                (((b) & 0x08) ? 0xF0 : 0) | (((b) & 0x04) ? 0x0F : 0), \
+                                (((b) & 0x02) ? 0xF0 : 0) | (((b) & 0x01) ? 0x0F : 0)}
+#define SSD1325Z2_EXPAND4(b)   SSD1325Z2_EXPAND(b),    SSD1325Z2_EXPAND(b+1),    \
+                               SSD1325Z2_EXPAND(b+2),  SSD1325Z2_EXPAND(b+3)
+#define SSD1325Z2_EXPAND16(b)  SSD1325Z2_EXPAND4(b),   SSD1325Z2_EXPAND4(b+4),   \
+                               SSD1325Z2_EXPAND4(b+8), SSD1325Z2_EXPAND4(b+12)
+#define SSD1325Z2_EXPAND64(b)  SSD1325Z2_EXPAND16(b),  SSD1325Z2_EXPAND16(b+16), \
+                               SSD1325Z2_EXPAND16(b+32), SSD1325Z2_EXPAND16(b+48)
+
+/** Pixels of every 1-bit byte, with the nibble layout of the buffer */
+static const uint8_t SSD1325Z2_expandBits[256][4] =
+{
+    SSD1325Z2_EXPAND64(0),   SSD1325Z2_EXPAND64(64),
+    SSD1325Z2_EXPAND64(128), SSD1325Z2_EXPAND64(192),
+};
+
+GDL_Errors SSD1325Z2_drawPicture (SSD1325Z2_DeviceHandle dev,
+                                  uint16_t xPos,
+                                  uint16_t yPos,
+                                  uint16_t width,
+                                  uint16_t height,
+                                  const uint8_t* picture,
                                   GDL_PictureType pixelType)
 {
     if ((pixelType != GDL_PICTURETYPE_1BIT) && (pixelType != GDL_PICTURETYPE_4BIT))
         return GDL_ERRORS_WRONG_VALUE;
 
-    return GDL_drawPicture(&(dev->gdl),xPos,yPos,width,height,picture,pixelType);
+    if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    if ((width == 0) || (height == 0))
+        return GDL_ERRORS_OK;
+
+    // Only the visible part is drawn
+    uint16_t visibleWidth = (xPos + width > dev->gdl.width) ? (dev->gdl.width - xPos) : width;
+    uint16_t visibleHeight = (yPos + height > dev->gdl.height) ? (dev->gdl.height - yPos) : height;
+
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+    if (dev->isRecording)
+    {
+        SSD1325Z2_ListPicture operation = {picture, xPos, yPos, width, height, pixelType};
+        SSD1325Z2_record(dev,SSD1325Z2_LISTTYPE_PICTURE,TRUE,xPos,xPos + visibleWidth - 1,
+                         yPos,yPos + visibleHeight - 1,&operation,sizeof(operation),NULL,0);
+        return GDL_ERRORS_OK;
+    }
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+    // Only the rows into the current band are drawn
+    if ((yPos > dev->bandStop) || (yPos + visibleHeight <= dev->bandStart))
+        return GDL_ERRORS_OK;
+    if (yPos < dev->bandStart)
+    {
+        uint16_t skipped = dev->bandStart - yPos;
+        picture += skipped * ((pixelType == GDL_PICTURETYPE_4BIT) ? ((width + 1)/2) : ((width + 7)/8));
+        visibleHeight -= skipped;
+        yPos = dev->bandStart;
+    }
+    if (yPos + visibleHeight - 1 > dev->bandStop)
+        visibleHeight = dev->bandStop - yPos + 1;
+#endif
+
+    if (pixelType == GDL_PICTURETYPE_4BIT)
+    {
+        uint16_t stride = (width + 1)/2;
+
+        for (uint16_t i = 0; i < visibleHeight; i++, picture += stride)
+            SSD1325Z2_copyNibbles(&dev->buffer[SSD1325Z2_rowOffset(dev,yPos + i)],xPos,picture,0,visibleWidth);
+    }
+    else
+    {
+        uint16_t stride = (width + 7)/8;
+        uint16_t visibleBytes = (visibleWidth + 7)/8;
+        // Expanded row, aligned to the picture
+        uint8_t pixels [(SSD1325Z2_MAX_WIDTH + 7)/8 * 4];
+
+        for (uint16_t i = 0; i < visibleHeight; i++, picture += stride)
+        {
+            for (uint16_t j = 0; j < visibleBytes; j++)
+                memcpy(&pixels[j * 4],SSD1325Z2_expandBits[picture[j]],4);
+            SSD1325Z2_copyNibbles(&dev->buffer[SSD1325Z2_rowOffset(dev,yPos + i)],xPos,pixels,0,visibleWidth);
+        }
+    }
+
+    SSD1325Z2_markDirty(dev,xPos,xPos + visibleWidth - 1,yPos,yPos + visibleHeight - 1);
+    return GDL_ERRORS_OK;
+}
+
+/**
+ * Level of every 8-bit gray value with 4 fractional bits, from 0 to 240.
+ */
+static const uint8_t SSD1325Z2_quantize[256] =
+{
+      0,   1,   2,   3,   4,   5,   6,   7,   8,   8,   9,  10,  11,  12,  13,  14,
+     15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  24,  25,  26,  27,  28,  29,
+     30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  40,  41,  42,  43,  44,
+     45,  46,  47,  48,  49,  50,  51,  52,  53,  54,  55,  56,  56,  57,  58,  59,
+     60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,  72,  72,  73,  74,
+     75,  76,  77,  78,  79,  80,  81,  82,  83,  84,  85,  86,  87,  88,  88,  89,
+     90,  91,  92,  93,  94,  95,  96,  97,  98,  99, 100, 101, 102, 103, 104, 104,
+    105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120,
+    120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135,
+    136, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 148, 149, 150,
+    151, 152, 152, 153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 163, 164, 165,
+    166, 167, 168, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180,
+    181, 182, 183, 184, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194, 195,
+    196, 197, 198, 199, 200, 200, 201, 202, 203, 204, 205, 206, 207, 208, 209, 210,
+    211, 212, 213, 214, 215, 216, 216, 217, 218, 219, 220, 221, 222, 223, 224, 225,
+    226, 227, 228, 229, 230, 231, 232, 232, 233, 234, 235, 236, 237, 238, 239, 240,
+};
+
+/** Thresholds of the ordered dithering, with 4 fractional bits */
+static const uint8_t SSD1325Z2_bayer[4][4] =
+{
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5},
+};
+
+GDL_Errors SSD1325Z2_drawGrayImage (SSD1325Z2_DeviceHandle dev,
+                                    uint16_t xPos,
+                                    uint16_t yPos,
+                                    uint16_t width,
+                                    uint16_t height,
+                                    const uint8_t* image,
+                                    uint16_t stride,
+                                    SSD1325Z2_Dither dither)
+{
+    SSD1325Z2_REJECT_RECORDING(dev,GDL_ERRORS_WRONG_VALUE);
+
+    if (dither > SSD1325Z2_DITHER_FLOYDSTEINBERG)
+        return GDL_ERRORS_WRONG_VALUE;
+
+    if ((xPos >= dev->gdl.width) || (yPos >= dev->gdl.height))
+        return GDL_ERRORS_WRONG_POSITION;
+
+    if ((width == 0) || (height == 0))
+        return GDL_ERRORS_OK;
+
+    // Only the visible part is drawn
+    uint16_t visibleWidth = (xPos + width > dev->gdl.width) ? (dev->gdl.width - xPos) : width;
+    uint16_t visibleHeight = (yPos + height > dev->gdl.height) ? (dev->gdl.height - yPos) : height;
+    // First row written into the buffer
+    uint16_t yFirst = yPos;
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+    // Only the rows into the current band are written, but the error
+    // diffusion needs the rows above it too
+    if ((yPos > dev->bandStop) || (yPos + visibleHeight <= dev->bandStart))
+        return GDL_ERRORS_OK;
+    if (yPos + visibleHeight - 1 > dev->bandStop)
+        visibleHeight = dev->bandStop - yPos + 1;
+    if (yPos < dev->bandStart)
+    {
+        yFirst = dev->bandStart;
+        if (dither != SSD1325Z2_DITHER_FLOYDSTEINBERG)
+        {
+            image += (yFirst - yPos) * stride;
+            visibleHeight -= yFirst - yPos;
+            yPos = yFirst;
+        }
+    }
+#endif
+
+    // Converted row, aligned to the image
+    uint8_t pixels [SSD1325Z2_MAX_WIDTH / 2];
+    // Error for the next row, 16 times the level with 4 fractional bits: the
+    // element x + 1 belongs to the column x
+    int16_t errors [SSD1325Z2_MAX_WIDTH + 2];
+
+    if (dither == SSD1325Z2_DITHER_FLOYDSTEINBERG)
+        memset(errors,0,sizeof(errors));
+
+    for (uint16_t y = yPos; y < yPos + visibleHeight; y++, image += stride)
+    {
+        if (dither == SSD1325Z2_DITHER_NONE)
+        {
+            for (uint16_t x = 0; x < visibleWidth; x += 2)
+            {
+                uint8_t high = (SSD1325Z2_quantize[image[x]] + 8) >> 4;
+                uint8_t low = (x + 1 < visibleWidth) ? ((SSD1325Z2_quantize[image[x + 1]] + 8) >> 4) : 0;
+                pixels[x/2] = (high << 4) | low;
+            }
+        }
+        else if (dither == SSD1325Z2_DITHER_ORDERED)
+        {
+            // The threshold follows the display, not the image
+            const uint8_t* bayer = SSD1325Z2_bayer[y & 3];
+            for (uint16_t x = 0; x < visibleWidth; x += 2)
+            {
+                uint8_t high = (SSD1325Z2_quantize[image[x]] + bayer[(xPos + x) & 3]) >> 4;
+                uint8_t low = (x + 1 < visibleWidth) ?
+                              ((SSD1325Z2_quantize[image[x + 1]] + bayer[(xPos + x + 1) & 3]) >> 4) : 0;
+                pixels[x/2] = (high << 4) | low;
+            }
+        }
+        else
+        {
+            // The errors of the next row are written one column late, when
+            // the errors of this row in the same place are already used
+            int16_t right = 0;
+            int16_t belowLeft = 0;
+            int16_t below = 0;
+
+            for (uint16_t x = 0; x < visibleWidth; x++)
+            {
+                int16_t value = SSD1325Z2_quantize[image[x]] + (errors[x + 1] + right) / 16;
+                int16_t level = (value + 8) >> 4;
+                if (level < 0) level = 0;
+                if (level > 15) level = 15;
+                int16_t error = value - (level << 4);
+
+                right = error * 7;
+                errors[x] = belowLeft + error * 3;
+                belowLeft = below + error * 5;
+                below = error;
+
+                if (x & 1)
+                    pixels[x/2] |= (uint8_t)level;
+                else
+                    pixels[x/2] = (uint8_t)(level << 4);
+            }
+            errors[visibleWidth] = belowLeft;
+
+            if (y < yFirst)
+                continue;
+        }
+
+        SSD1325Z2_copyNibbles(&dev->buffer[SSD1325Z2_rowOffset(dev,y)],xPos,
+                              pixels,0,visibleWidth);
+    }
+
+    SSD1325Z2_markDirty(dev,xPos,xPos + visibleWidth - 1,yFirst,yPos + visibleHeight - 1);
+    return GDL_ERRORS_OK;
+}
+
+/*
+ * Operations on the packed nibbles, eight pixels at a time: the even and the
+ * odd nibbles of a word are split into bytes, so every pixel has four spare
+ * bits for carries, borrows and products up to 15 * 15.
+ */
+#define SSD1325Z2_NIBBLES_LOW                    0x0F0F0F0Ful
+#define SSD1325Z2_NIBBLES_CARRY                  0x10101010ul
+#define SSD1325Z2_NIBBLES_ONE                    0x01010101ul
+
+/**
+ * The function divides every byte by 15, rounding down: it is exact for
+ * every value up to 15 * 15.
+ */
+static inline uint32_t SSD1325Z2_nibblesDivide15 (uint32_t value)
+{
+    value += ((value >> 4) & SSD1325Z2_NIBBLES_LOW) + SSD1325Z2_NIBBLES_ONE;
+    return (value >> 4) & SSD1325Z2_NIBBLES_LOW;
+}
+
+static uint32_t SSD1325Z2_nibblesInvert (uint32_t word, uint32_t other, uint8_t level)
+{
+    (void)other;
+    (void)level;
+    return ~word;
+}
+
+static inline uint32_t SSD1325Z2_nibblesAddHalf (uint32_t half, uint32_t levels)
+{
+    uint32_t sum = half + levels;
+    uint32_t carry = sum & SSD1325Z2_NIBBLES_CARRY;
+    // Lanes with a carry are saturated to 15
+    return (sum | (carry - (carry >> 4))) & SSD1325Z2_NIBBLES_LOW;
+}
+
+static uint32_t SSD1325Z2_nibblesAdd (uint32_t word, uint32_t other, uint8_t level)
+{
+    (void)other;
+    uint32_t levels = SSD1325Z2_NIBBLES_ONE * level;
+    return SSD1325Z2_nibblesAddHalf(word & SSD1325Z2_NIBBLES_LOW,levels) |
+           (SSD1325Z2_nibblesAddHalf((word >> 4) & SSD1325Z2_NIBBLES_LOW,levels) << 4);
+}
+
+static inline uint32_t SSD1325Z2_nibblesSubtractHalf (uint32_t half, uint32_t levels)
+{
+    uint32_t difference = (half | SSD1325Z2_NIBBLES_CARRY) - levels;
+    uint32_t kept = difference & SSD1325Z2_NIBBLES_CARRY;
+    // Lanes with a borrow are saturated to 0
+    return difference & (kept - (kept >> 4));
+}
+
+static uint32_t SSD1325Z2_nibblesSubtract (uint32_t word, uint32_t other, uint8_t level)
+{
+    (void)other;
+    uint32_t levels = SSD1325Z2_NIBBLES_ONE * level;
+    return SSD1325Z2_nibblesSubtractHalf(word & SSD1325Z2_NIBBLES_LOW,levels) |
+           (SSD1325Z2_nibblesSubtractHalf((word >> 4) & SSD1325Z2_NIBBLES_LOW,levels) << 4);
+}
+
+static uint32_t SSD1325Z2_nibblesScale (uint32_t word, uint32_t other, uint8_t level)
+{
+    (void)other;
+    return SSD1325Z2_nibblesDivide15((word & SSD1325Z2_NIBBLES_LOW) * level) |
+           (SSD1325Z2_nibblesDivide15(((word >> 4) & SSD1325Z2_NIBBLES_LOW) * level) << 4);
+}
+
+static uint32_t SSD1325Z2_nibblesBlend (uint32_t word, uint32_t other, uint8_t level)
+{
+    uint8_t inverse = 15 - level;
+    uint32_t low = (word & SSD1325Z2_NIBBLES_LOW) * inverse +
+                   (other & SSD1325Z2_NIBBLES_LOW) * level;
+    uint32_t high = ((word >> 4) & SSD1325Z2_NIBBLES_LOW) * inverse +
+                    ((other >> 4) & SSD1325Z2_NIBBLES_LOW) * level;
+    return SSD1325Z2_nibblesDivide15(low) | (SSD1325Z2_nibblesDivide15(high) << 4);
+}
+
+/**
+ * The function applies an operation to a run of bytes, a word at a time.
+ * The words are copied, so the bytes don't need any alignment.
+ */
+static inline void SSD1325Z2_nibblesRun (uint8_t* data,
+                                         const uint8_t* other,
+                                         uint16_t length,
+                                         uint32_t (*operation)(uint32_t,uint32_t,uint8_t),
+                                         uint8_t level)
+{
+    uint32_t word;
+    uint32_t otherWord = 0;
+
+    for (; length >= 4; length -= 4, data += 4)
+    {
+        memcpy(&word,data,4);
+        if (other != NULL)
+        {
+            memcpy(&otherWord,other,4);
+            other += 4;
+        }
+        word = operation(word,otherWord,level);
+        memcpy(data,&word,4);
+    }
+    if (length > 0)
+    {
+        memcpy(&word,data,length);
+        if (other != NULL)
+            memcpy(&otherWord,other,length);
+        word = operation(word,otherWord,level);
+        memcpy(data,&word,length);
+    }
+}
+
+/**
+ * The function applies an operation to the pixels of an area of the buffer.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] area The area, NULL for the whole display
+ * @param[in] other The pixels of the whole display used by the operation,
+ *                  NULL when it doesn't need them
+ * @param[in] operation The operation on the words
+ * @param[in] level The level used by the operation
+ * @return GDL_ERRORS_WRONG_POSITION if the area is outside of the display,
+ *         GDL_ERRORS_OK otherwise.
+ */
+static inline GDL_Errors SSD1325Z2_nibblesArea (SSD1325Z2_DeviceHandle dev,
+                                                const SSD1325Z2_Rect* area,
+                                                const uint8_t* other,
+                                                uint32_t (*operation)(uint32_t,uint32_t,uint8_t),
+                                                uint8_t level)
+{
+    SSD1325Z2_REJECT_RECORDING(dev,GDL_ERRORS_WRONG_VALUE);
+
+    SSD1325Z2_Rect rect = {0, dev->gdl.width - 1, 0, dev->gdl.height - 1};
+
+    if (area != NULL)
+    {
+        if ((area->xStart > area->xStop) || (area->xStop >= dev->gdl.width) ||
+            (area->yStart > area->yStop) || (area->yStop >= dev->gdl.height))
+            return GDL_ERRORS_WRONG_POSITION;
+        rect = *area;
+    }
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+    // Only the rows into the current band are changed
+    if (rect.yStart < dev->bandStart)
+        rect.yStart = dev->bandStart;
+    if (rect.yStop > dev->bandStop)
+        rect.yStop = dev->bandStop;
+    if (rect.yStart > rect.yStop)
+        return GDL_ERRORS_OK;
+#endif
+
+    uint8_t widthHalf = SSD1325Z2_STRIDE(dev);
+    if (other != NULL)
+        other += rect.yStart * widthHalf + rect.xStart/2;
+    uint8_t length = rect.xStop/2 - rect.xStart/2 + 1;
+    uint8_t rows = rect.yStop - rect.yStart + 1;
+
+    if ((rect.xStart == 0) && (rect.xStop == dev->gdl.width - 1) &&
+        (SSD1325Z2_rowOffset(dev,rect.yStop) >= SSD1325Z2_rowOffset(dev,rect.yStart)))
+    {
+        // Full rows are contiguous, when they don't wrap into the ring
+        SSD1325Z2_nibblesRun(&dev->buffer[SSD1325Z2_rowOffset(dev,rect.yStart)],other,
+                             (uint16_t)length * rows,operation,level);
+    }
+    else
+    {
+        for (uint8_t i = 0; i < rows; i++)
+        {
+            uint8_t* row = &dev->buffer[SSD1325Z2_rowOffset(dev,rect.yStart + i) + rect.xStart/2];
+
+            // The nibbles of the edges outside of the area are kept
+            uint8_t first = row[0];
+            uint8_t last = row[length - 1];
+
+            SSD1325Z2_nibblesRun(row,other,length,operation,level);
+            if (rect.xStart & 1)
+                row[0] = (first & 0xF0) | (row[0] & 0x0F);
+            if ((rect.xStop & 1) == 0)
+                row[length - 1] = (row[length - 1] & 0xF0) | (last & 0x0F);
+
+            if (other != NULL)
+                other += widthHalf;
+        }
+    }
+
+    SSD1325Z2_markDirty(dev,rect.xStart,rect.xStop,rect.yStart,rect.yStop);
+    return GDL_ERRORS_OK;
+}
+
+GDL_Errors SSD1325Z2_invertArea (SSD1325Z2_DeviceHandle dev, const SSD1325Z2_Rect* area)
+{
+    return SSD1325Z2_nibblesArea(dev,area,NULL,SSD1325Z2_nibblesInvert,0);
+}
+
+GDL_Errors SSD1325Z2_addArea (SSD1325Z2_DeviceHandle dev,
+                              const SSD1325Z2_Rect* area,
+                              uint8_t level)
+{
+    if (level > 15) return GDL_ERRORS_WRONG_VALUE;
+    return SSD1325Z2_nibblesArea(dev,area,NULL,SSD1325Z2_nibblesAdd,level);
+}
+
+GDL_Errors SSD1325Z2_subtractArea (SSD1325Z2_DeviceHandle dev,
+                                   const SSD1325Z2_Rect* area,
+                                   uint8_t level)
+{
+    if (level > 15) return GDL_ERRORS_WRONG_VALUE;
+    return SSD1325Z2_nibblesArea(dev,area,NULL,SSD1325Z2_nibblesSubtract,level);
+}
+
+GDL_Errors SSD1325Z2_scaleArea (SSD1325Z2_DeviceHandle dev,
+                                const SSD1325Z2_Rect* area,
+                                uint8_t level)
+{
+    if (level > 15) return GDL_ERRORS_WRONG_VALUE;
+    return SSD1325Z2_nibblesArea(dev,area,NULL,SSD1325Z2_nibblesScale,level);
+}
+
+GDL_Errors SSD1325Z2_blendArea (SSD1325Z2_DeviceHandle dev,
+                                const SSD1325Z2_Rect* area,
+                                const uint8_t* picture,
+                                uint8_t level)
+{
+    if ((picture == NULL) || (level > 15)) return GDL_ERRORS_WRONG_VALUE;
+    return SSD1325Z2_nibblesArea(dev,area,picture,SSD1325Z2_nibblesBlend,level);
+}
+
+#if defined WARCOMEB_SSD1325Z2_USE_STATISTICS
+void SSD1325Z2_resetStatistics (SSD1325Z2_DeviceHandle dev)
+{
+    memset(&dev->statistics,0,sizeof(SSD1325Z2_Statistics));
 }
+#endif
 
 void SSD1325Z2_displayOn (SSD1325Z2_DeviceHandle dev)
 {
@@ -372,9 +3238,119 @@ GDL_Errors SSD1325Z2_setContrast (SSD1325Z2_DeviceHandle dev, uint8_t value)
 {
     if (value > 0x7F) return GDL_ERRORS_WRONG_VALUE;
 
-    // Set column address
-    SSD1325Z2_sendCommand(dev,SSD1325Z2_CMD_SETCONTRAST);
-    SSD1325Z2_sendCommand(dev,value);
+    const uint8_t commands[2] = {SSD1325Z2_CMD_SETCONTRAST, value};
+    SSD1325Z2_sendCommandBlock(dev,commands,2);
+
+    return GDL_ERRORS_OK;
+}
+
+GDL_Errors SSD1325Z2_setGrayTable (SSD1325Z2_DeviceHandle dev, const uint8_t* pulses)
+{
+    uint8_t commands [1 + 8] = {SSD1325Z2_CMD_GRAYSCALETABLE};
+    uint8_t last = 0;
+
+    // Every level is sent as the increment from the previous one
+    for (uint8_t i = 0; i < 15; i++)
+    {
+        if ((pulses[i] < last) || (pulses[i] - last > 7))
+            return GDL_ERRORS_WRONG_VALUE;
+
+        commands[1 + i/2] |= (uint8_t)((pulses[i] - last) << ((i & 1) ? 4 : 0));
+        last = pulses[i];
+    }
+    SSD1325Z2_sendCommandBlock(dev,commands,sizeof(commands));
 
     return GDL_ERRORS_OK;
 }
+
+/** 2 raised to -1/2, -1/4, -1/8 and so on, with 16 fractional bits */
+static const uint16_t SSD1325Z2_exp2Steps[16] =
+{
+    46341, 55109, 60097, 62757, 64132, 64830, 65182, 65359,
+    65447, 65492, 65514, 65525, 65530, 65533, 65535, 65535,
+};
+
+/**
+ * The function computes the base 2 logarithm of a number with 16 fractional
+ * bits, bit by bit.
+ *
+ * @param[in] value The number, with 16 fractional bits, between 1/65536 and 1
+ * @return The logarithm, with 16 fractional bits.
+ */
+static int32_t SSD1325Z2_log2 (uint32_t value)
+{
+    int32_t result = 0;
+
+    while (value < 0x10000)
+    {
+        value <<= 1;
+        result -= 0x10000;
+    }
+    for (uint32_t bit = 0x8000; bit > 0; bit >>= 1)
+    {
+        value = (uint32_t)(((uint64_t)value * value) >> 16);
+        if (value >= 0x20000)
+        {
+            value >>= 1;
+            result += bit;
+        }
+    }
+    return result;
+}
+
+/**
+ * The function computes 2 raised to a negative number.
+ *
+ * @param[in] value The exponent, with 16 fractional bits, not greater than 0
+ * @return The power, with 16 fractional bits.
+ */
+static uint32_t SSD1325Z2_exp2 (int32_t value)
+{
+    uint32_t exponent = (uint32_t)(-value);
+    uint32_t result = 0x10000;
+
+    if ((exponent >> 16) > 16)
+        return 0;
+
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        if (exponent & (0x8000 >> i))
+            result = (result * SSD1325Z2_exp2Steps[i]) >> 16;
+    }
+    return result >> (exponent >> 16);
+}
+
+GDL_Errors SSD1325Z2_setGamma (SSD1325Z2_DeviceHandle dev, uint8_t gamma)
+{
+    if ((gamma < 5) || (gamma > 40))
+        return GDL_ERRORS_WRONG_VALUE;
+
+    // Brightness of every level, from 0 to 1 with 16 fractional bits
+    uint32_t brightness [16];
+    uint32_t step = 0;
+
+    brightness[0] = 0;
+    for (uint8_t i = 1; i < 16; i++)
+    {
+        int32_t logarithm = SSD1325Z2_log2(((uint32_t)i << 16) / 15);
+        brightness[i] = SSD1325Z2_exp2(logarithm * gamma / 10);
+        if (brightness[i] - brightness[i-1] > step)
+            step = brightness[i] - brightness[i-1];
+    }
+
+    // The widest step of the curve uses the longest increment of the table,
+    // every level is at least one clock longer than the previous one
+    uint8_t pulses [15];
+    uint8_t last = 0;
+    for (uint8_t i = 1; i < 16; i++)
+    {
+        uint32_t target = (brightness[i] * 7 + step/2) / step;
+        uint8_t increment = (target > last) ? (uint8_t)(target - last) : 0;
+
+        if (increment < 1) increment = 1;
+        if (increment > 7) increment = 7;
+        last += increment;
+        pulses[i-1] = last;
+    }
+    return SSD1325Z2_setGrayTable(dev,pulses);
+}
@@ -47,12 +47,105 @@
 #include "board.h"
 #endif
 
-#if !defined(WARCOMEB_SSD1325Z2_HEIGHT) | !defined(WARCOMEB_SSD1325Z2_WIDTH)
-#error "You must define height and width of display!"
+/*
+ * The user can render the display in bands of rows, to save memory: the
+ * buffer holds only a band of the display, and the frame is drawn with
+ * SSD1325Z2_renderBands. The user can define the rows of a band:
+ *     #define WARCOMEB_SSD1325Z2_USE_BANDS
+ *     #define WARCOMEB_SSD1325Z2_BAND_ROWS      xx
+ */
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+#ifndef WARCOMEB_SSD1325Z2_BAND_ROWS
+#define WARCOMEB_SSD1325Z2_BAND_ROWS 8
+#endif
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER | defined WARCOMEB_SSD1325Z2_USE_ACCELERATION
+#error "The bands can't be used with shadow buffer or acceleration!"
+#endif
+#endif
+
+/*
+ * The user can draw and flush from different contexts, with three frames:
+ * the drawing functions work on the render frame, SSD1325Z2_present makes it
+ * the newest frame, and SSD1325Z2_flushFrame sends the newest frame. Both
+ * functions never wait each other, and the frames never displayed are
+ * dropped. The scroll of the console sends from the drawing context and
+ * rotates the rows of every frame, so it isn't available with frames.
+ * The user can define the atomic exchange of a byte, by default the one
+ * of GCC:
+ *     #define WARCOMEB_SSD1325Z2_USE_FRAMES
+ *     #define WARCOMEB_SSD1325Z2_ATOMIC_EXCHANGE(pointer,value) xx
+ */
+#if defined WARCOMEB_SSD1325Z2_USE_FRAMES
+#ifndef WARCOMEB_SSD1325Z2_ATOMIC_EXCHANGE
+#define WARCOMEB_SSD1325Z2_ATOMIC_EXCHANGE(pointer,value) \
+    __atomic_exchange_n((pointer),(value),__ATOMIC_ACQ_REL)
+#endif
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS | defined WARCOMEB_SSD1325Z2_USE_ACCELERATION
+#error "The frames can't be used with bands or acceleration!"
+#endif
+#define SSD1325Z2_FRAMES               3
+#else
+#define SSD1325Z2_FRAMES               1
+#endif
+
+/*
+ * The user can record the drawing into a display list, and draw it when it
+ * is committed: the operations hidden by the following fills are dropped,
+ * and with the bands every band is drawn and sent once. The user can define
+ * the bytes of the list:
+ *     #define WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+ *     #define WARCOMEB_SSD1325Z2_DISPLAYLIST_BYTES xx
+ */
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+#ifndef WARCOMEB_SSD1325Z2_DISPLAYLIST_BYTES
+#define WARCOMEB_SSD1325Z2_DISPLAYLIST_BYTES 512
+#endif
+#if (WARCOMEB_SSD1325Z2_DISPLAYLIST_BYTES < 64) | (WARCOMEB_SSD1325Z2_DISPLAYLIST_BYTES > 65535)
+#error "The display list must be between 64 and 65535 bytes!"
+#endif
+#endif
+
+/*
+ * The user can give the size of the display and the buffer at runtime, with
+ * SSD1325Z2_initWithBuffer, to drive displays of different size or to place
+ * the buffer in a selected memory. In this case height and width are not
+ * needed; when they are defined too, SSD1325Z2_init is still available and
+ * it uses a buffer into the device:
+ *     #define WARCOMEB_SSD1325Z2_USE_EXTERNAL_BUFFER
+ */
+#if defined WARCOMEB_SSD1325Z2_USE_EXTERNAL_BUFFER
+
+/** Rows stored into the buffer, for a display of the given height */
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+#define SSD1325Z2_BUFFER_ROWS(height)  (WARCOMEB_SSD1325Z2_BAND_ROWS)
+#else
+#define SSD1325Z2_BUFFER_ROWS(height)  (height)
+#endif
+
+/** Bytes of the buffer to give to SSD1325Z2_initWithBuffer */
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+#define SSD1325Z2_BUFFER_BYTES(width,height) \
+    ((width)*SSD1325Z2_BUFFER_ROWS(height)/2*(SSD1325Z2_FRAMES + 1))
+#else
+#define SSD1325Z2_BUFFER_BYTES(width,height) \
+    ((width)*SSD1325Z2_BUFFER_ROWS(height)/2*SSD1325Z2_FRAMES)
+#endif
+
+#endif
+
+#if defined(WARCOMEB_SSD1325Z2_HEIGHT) & defined(WARCOMEB_SSD1325Z2_WIDTH)
+/** The size of the display is known at build time, for SSD1325Z2_init */
+#define SSD1325Z2_FIXED_SIZE
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+// Every byte represent 2 pixel, only the rows of a band are stored
+#define WARCOMEB_SSD1325Z2_BUFFERDIMENSION (WARCOMEB_SSD1325Z2_WIDTH*WARCOMEB_SSD1325Z2_BAND_ROWS/2)
 #else
 // Every byte represent 2 pixel...
 #define WARCOMEB_SSD1325Z2_BUFFERDIMENSION (WARCOMEB_SSD1325Z2_WIDTH*WARCOMEB_SSD1325Z2_HEIGHT/2)
 #endif
+#elif !defined WARCOMEB_SSD1325Z2_USE_EXTERNAL_BUFFER
+#error "You must define height and width of display!"
+#endif
 
 #if defined(WARCOMEB_SSD1325Z2_HEIGHT) & ((WARCOMEB_SSD1325Z2_HEIGHT < 16) | (WARCOMEB_SSD1325Z2_HEIGHT > 80))
 #error "The height must be between 16 and 128!"
@@ -62,6 +155,87 @@
 #error "The width must be between 16 and 128!"
 #endif
 
+/*
+ * The user can define the maximum number of separate dirty rectangles
+ * tracked by the driver. When all of them are used, the new damage is merged
+ * into the rectangle that grows less.
+ *     #define WARCOMEB_SSD1325Z2_DIRTY_RECTANGLES xx
+ */
+#ifndef WARCOMEB_SSD1325Z2_DIRTY_RECTANGLES
+#define WARCOMEB_SSD1325Z2_DIRTY_RECTANGLES 4
+#endif
+
+#if (WARCOMEB_SSD1325Z2_DIRTY_RECTANGLES < 1)
+#error "The number of dirty rectangles must be at least 1!"
+#endif
+
+/*
+ * The user can enable a lookup table with the port masks of every byte value,
+ * used when the data pins are on the same port but not contiguous:
+ *     #define WARCOMEB_SSD1325Z2_PARALLEL_PORT_LUT
+ */
+
+/*
+ * The user can enable a cache of the rasterized chars, defining the number
+ * of glyphs kept into it (0, the default, disables it), and the maximum char
+ * size cached:
+ *     #define WARCOMEB_SSD1325Z2_GLYPH_CACHE_ENTRIES xx
+ *     #define WARCOMEB_SSD1325Z2_GLYPH_CACHE_MAXSIZE xx
+ */
+#ifndef WARCOMEB_SSD1325Z2_GLYPH_CACHE_ENTRIES
+#define WARCOMEB_SSD1325Z2_GLYPH_CACHE_ENTRIES 0
+#endif
+
+#ifndef WARCOMEB_SSD1325Z2_GLYPH_CACHE_MAXSIZE
+#define WARCOMEB_SSD1325Z2_GLYPH_CACHE_MAXSIZE 1
+#endif
+
+/*
+ * The user can enable the statistics of the driver and the hooks called at
+ * begin and end of the main operations:
+ *     #define WARCOMEB_SSD1325Z2_USE_STATISTICS
+ */
+
+/*
+ * The user can enable the graphic acceleration commands of the controller,
+ * and define the time in milliseconds they need to complete. The driver waits
+ * it only before a RAM access that overlaps the area of the last command, or
+ * before the next command:
+ *     #define WARCOMEB_SSD1325Z2_USE_ACCELERATION
+ *     #define WARCOMEB_SSD1325Z2_ACCELERATION_DELAY xx
+ */
+#if defined WARCOMEB_SSD1325Z2_USE_ACCELERATION
+#ifndef WARCOMEB_SSD1325Z2_ACCELERATION_DELAY
+#define WARCOMEB_SSD1325Z2_ACCELERATION_DELAY 1
+#endif
+#endif
+
+/*
+ * The user can define the time in milliseconds between the display on and
+ * the setup of the display, while the supply of the panel becomes stable:
+ *     #define WARCOMEB_SSD1325Z2_POWERUP_DELAY xx
+ */
+#ifndef WARCOMEB_SSD1325Z2_POWERUP_DELAY
+#define WARCOMEB_SSD1325Z2_POWERUP_DELAY 100
+#endif
+
+#if defined WARCOMEB_GDL_I2C
+/*
+ * The user can define the default maximum number of bytes, after the control
+ * byte, sent into a single I2C transaction:
+ *     #define WARCOMEB_SSD1325Z2_I2C_MAX_TRANSACTION xx
+ */
+#ifndef WARCOMEB_SSD1325Z2_I2C_MAX_TRANSACTION
+#define WARCOMEB_SSD1325Z2_I2C_MAX_TRANSACTION 255
+#endif
+#endif
+
+/*
+ * The user can enable a second copy of the buffer with the last data sent to
+ * the display, needed by @ref SSD1325Z2_flushChanges:
+ *     #define WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+ */
+
 /**
  * A usefull enum that define all the possbile color for each pixel.
  */
@@ -90,29 +264,425 @@ typedef enum _SSD1325Z2_Product
 	SSD1325Z2_PRODUCT_RAYSTAR_REX012864F   = 0x0001 | GDL_MODELTYPE_SSD1325,
 } SSD1325Z2_Product;
 
+/**
+ * Dithering used to convert 8-bit gray images.
+ */
+typedef enum _SSD1325Z2_Dither
+{
+    SSD1325Z2_DITHER_NONE,                   /**< Nearest level of the pixel */
+    SSD1325Z2_DITHER_ORDERED,                  /**< 4x4 Bayer thresholds */
+    SSD1325Z2_DITHER_FLOYDSTEINBERG,           /**< Floyd-Steinberg error diffusion */
+} SSD1325Z2_Dither;
+
+/**
+ * A rectangular area of the display, all the bounds are inclusive.
+ */
+typedef struct _SSD1325Z2_Rect
+{
+    uint8_t xStart;
+    uint8_t xStop;
+    uint8_t yStart;
+    uint8_t yStop;
+} SSD1325Z2_Rect;
+
+/**
+ * The operations used to send commands and data to the controller.
+ * Every function receive the bus pointer saved into the device.
+ */
+typedef struct _SSD1325Z2_BusOps
+{
+    /** Send a command byte */
+    void (*writeCommand) (void* bus, uint8_t command);
+    /** Send a data byte */
+    void (*writeData) (void* bus, uint8_t value);
+    /**
+     * Send a sequence of command bytes as a single transfer.
+     * It can be NULL, in this case writeCommand is used for every byte.
+     */
+    void (*writeCommandBlock) (void* bus, const uint8_t* commands, uint16_t length);
+    /** Send a block of data bytes */
+    void (*writeDataBlock) (void* bus, const uint8_t* data, uint16_t length);
+    /**
+     * Start to send a block of data bytes and return immediately. When the
+     * last byte is sent, done must be called with its argument.
+     * It can be NULL, in this case writeDataBlock is used.
+     */
+    void (*writeDataBlockAsync) (void* bus,
+                                 const uint8_t* data,
+                                 uint16_t length,
+                                 void (*done)(void* argument),
+                                 void* argument);
+} SSD1325Z2_BusOps;
+
+#if defined WARCOMEB_GDL_I2C
+/**
+ * The engine that sends the transactions on the I2C bus. It can be the
+ * peripheral of the microcontroller, or a stand-in for tests on host.
+ */
+typedef struct _SSD1325Z2_I2cEngine
+{
+    /**
+     * Send a transaction: start, the device address, the control byte,
+     * the bytes and stop. Return when all of them are sent.
+     */
+    void (*write) (void* context,
+                   uint8_t address,
+                   uint8_t control,
+                   const uint8_t* data,
+                   uint16_t length);
+} SSD1325Z2_I2cEngine;
+#endif
+
+#if defined WARCOMEB_GDL_SPI
+/**
+ * The engine that moves the bytes on the SPI bus, while the driver manages
+ * chip-select and data/command pins. It can be a peripheral with DMA, or a
+ * stand-in for tests on host.
+ */
+typedef struct _SSD1325Z2_SpiEngine
+{
+    /** Send the bytes and return when all of them are sent */
+    void (*write) (void* context, const uint8_t* data, uint16_t length);
+    /**
+     * Start to send the bytes and return immediately. When the last byte is
+     * sent, usually into the DMA interrupt, done must be called with its
+     * argument. It can be NULL, in this case write is used.
+     */
+    void (*writeAsync) (void* context,
+                        const uint8_t* data,
+                        uint16_t length,
+                        void (*done)(void* argument),
+                        void* argument);
+} SSD1325Z2_SpiEngine;
+#endif
+
+#if defined WARCOMEB_GDL_PARALLEL
+/**
+ * The description of the port where D0-D7 pins are connected, used to write
+ * a byte with a single store instead of eight pin writes.
+ */
+typedef struct _SSD1325Z2_ParallelPort
+{
+    /** Register that drives high the pins written to 1 */
+    volatile uint32_t* setRegister;
+    /**
+     * Register that drives low the pins written to 1. When it is NULL, the
+     * pins to clear are written into the upper half-word of setRegister with
+     * the same store (like the BSRR register of STM32 devices): in this case
+     * every data pin must be between bit 0 and bit 15, so D0 can't be after
+     * bit 8 for contiguous pins.
+     */
+    volatile uint32_t* clearRegister;
+    /** Mask of each data pin (D0 first) into the port registers */
+    uint32_t pinMask[8];
+
+    /** All data pins, computed by SSD1325Z2_setParallelPort */
+    uint32_t mask;
+    uint8_t shift;       /**< Position of D0 for contiguous pins, or 0xFF */
+#if defined WARCOMEB_SSD1325Z2_PARALLEL_PORT_LUT
+    /** Set mask for every byte, computed by SSD1325Z2_setParallelPort */
+    uint32_t lut[256];
+#endif
+} SSD1325Z2_ParallelPort;
+#endif
+
+#if (WARCOMEB_SSD1325Z2_GLYPH_CACHE_ENTRIES > 0)
+/** Bytes of the biggest glyph saved into the cache */
+#define SSD1325Z2_GLYPH_BYTES \
+    (((GDL_DEFAULT_FONT_WIDTH * WARCOMEB_SSD1325Z2_GLYPH_CACHE_MAXSIZE) + 1) / 2 * \
+     (GDL_DEFAULT_FONT_HEIGHT * WARCOMEB_SSD1325Z2_GLYPH_CACHE_MAXSIZE))
+
+/**
+ * A char rasterized with the same nibble layout of the buffer.
+ */
+typedef struct _SSD1325Z2_Glyph
+{
+    uint8_t c;                                               /**< The char */
+    uint8_t colors;            /**< Foreground and background color nibbles */
+    uint8_t size;                   /**< The size of the char, 0 when empty */
+    uint8_t data [SSD1325Z2_GLYPH_BYTES];
+} SSD1325Z2_Glyph;
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_STATISTICS
+/**
+ * Counters of the activity of the driver.
+ */
+typedef struct _SSD1325Z2_Statistics
+{
+    /** Frames or areas sent, once for every call of a flush function or of
+        @ref SSD1325Z2_renderBands, and once for an incremental flush */
+    uint32_t flushes;
+    uint32_t commandBytes;             /**< Bytes of commands sent */
+    uint32_t dataBytes;                   /**< Bytes of data sent */
+    uint32_t pixels;  /**< Pixels written with @ref SSD1325Z2_drawPixel */
+    uint32_t rejectedPixels;     /**< Pixels outside of the display */
+} SSD1325Z2_Statistics;
+
+/**
+ * The operations measured by the timestamp hooks.
+ */
+typedef enum _SSD1325Z2_Operation
+{
+    SSD1325Z2_OPERATION_INIT,
+    SSD1325Z2_OPERATION_FLUSH,
+    SSD1325Z2_OPERATION_FLUSHPART,
+    SSD1325Z2_OPERATION_FLUSHDIRTY,
+    SSD1325Z2_OPERATION_FLUSHCHANGES,
+    /** From the call to the end of the transfer, the end can be called by
+        the bus: @ref SSD1325Z2_flushAsync and @ref SSD1325Z2_flushFrame */
+    SSD1325Z2_OPERATION_FLUSHASYNC,
+    /** From @ref SSD1325Z2_flushBegin to the step that sends the last byte,
+        or to another flush that stops it */
+    SSD1325Z2_OPERATION_FLUSHSTEP,
+    /** All the bands of @ref SSD1325Z2_renderBands */
+    SSD1325Z2_OPERATION_RENDERBANDS,
+} SSD1325Z2_Operation;
+#endif
+
 typedef struct SSD1325Z2_Device
 {
     GDL_Device gdl;                         /**< Common part for each device */
 
+    /** Operations of the bus connected to the display, set by init */
+    const SSD1325Z2_BusOps* busOps;
+    void* bus;               /**< Argument passed to every bus operation */
+
 #if defined WARCOMEB_GDL_PARALLEL
 
+    /** Data port, used after SSD1325Z2_setParallelPort */
+    SSD1325Z2_ParallelPort port;
+
 #elif defined WARCOMEB_GDL_I2C
 
     Gpio_Pins rstPin;            /**< Reset pin used for start-up the display */
 
+    uint8_t address;                       /**< 7-bit address of the device */
+    /**
+     * Maximum number of bytes after the control byte of each transaction.
+     * When it is 0 at the initialization, the default value is used.
+     */
+    uint16_t maxTransaction;
+
+    const SSD1325Z2_I2cEngine* i2cEngine;     /**< Engine of the I2C bus */
+    void* i2cContext;           /**< Argument passed to the engine functions */
+
 #elif defined WARCOMEB_GDL_SPI
 
+    Gpio_Pins csPin;                                /**< Chip-select pin */
+    Gpio_Pins dcPin;                               /**< Data/command pin */
+    Gpio_Pins rstPin;            /**< Reset pin used for start-up the display */
+    Gpio_Pins sclkPin;              /**< Clock pin, used by default engine */
+    Gpio_Pins sdinPin;               /**< Data pin, used by default engine */
+
+    /**
+     * Engine of the SPI bus. When it is NULL at the initialization, the
+     * driver drives sclkPin and sdinPin by itself.
+     */
+    const SSD1325Z2_SpiEngine* spiEngine;
+    void* spiContext;           /**< Argument passed to the engine functions */
+
+    void (*spiDone)(void* argument);  /**< Pending end of an async transfer */
+    void* spiDoneArgument;
+
+#endif
+
+#if (WARCOMEB_SSD1325Z2_GLYPH_CACHE_ENTRIES > 0)
+    /** Chars already rasterized */
+    SSD1325Z2_Glyph glyphs [WARCOMEB_SSD1325Z2_GLYPH_CACHE_ENTRIES];
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_STATISTICS
+    SSD1325Z2_Statistics statistics;        /**< Counters of the activity */
+    /** Hook called at the begin of an operation, it can be NULL */
+    void (*operationBegin)(struct SSD1325Z2_Device* dev, SSD1325Z2_Operation operation);
+    /** Hook called at the end of an operation, it can be NULL */
+    void (*operationEnd)(struct SSD1325Z2_Device* dev, SSD1325Z2_Operation operation);
+#endif
+
+    uint32_t initTime;      /**< Time of the display on, in milliseconds */
+    bool isReady;          /**< TRUE when the setup of the display is sent */
+
+    uint8_t startLine;     /**< Row of the display RAM shown on the top row */
+#if !defined WARCOMEB_SSD1325Z2_USE_BANDS
+    uint8_t ringStart;         /**< Row of the buffer shown on the top row */
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+    uint8_t bandStart;           /**< First row of the display into the buffer */
+    uint8_t bandStop;             /**< Last row of the display into the buffer */
 #endif
 
+#if defined WARCOMEB_SSD1325Z2_USE_ACCELERATION
+    bool isAccelerated;      /**< TRUE when the graphic acceleration is used */
+    bool isAccelerating; /**< TRUE while the last command can still be running */
+    /** Columns and rows of the display RAM used by the last command */
+    SSD1325Z2_Rect accelerationArea;
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+    /** Operations recorded, one after the other */
+    uint8_t list [WARCOMEB_SSD1325Z2_DISPLAYLIST_BYTES];
+    uint16_t listLength;               /**< Bytes used into the list */
+    bool isRecording;           /**< TRUE while the drawing is recorded */
+    bool isListLost;          /**< TRUE when an operation was not recorded */
+#endif
+
+    /** TRUE while an asynchronous flush is sending the buffer */
+    volatile bool isFlushing;
+    /** Function called at the end of the asynchronous flush */
+    void (*flushCallback)(struct SSD1325Z2_Device* dev);
+
+    uint16_t stepPosition;      /**< Next byte of the incremental flush */
+    uint16_t stepWindowEnd;      /**< End of the window of the incremental flush */
+    bool isStepping;          /**< TRUE while an incremental flush is running */
+    bool isStepWindow;   /**< TRUE while the window is the incremental flush one */
+
     /** Buffer to store display data */
+#if defined WARCOMEB_SSD1325Z2_USE_EXTERNAL_BUFFER | defined WARCOMEB_SSD1325Z2_USE_FRAMES
+    uint8_t* buffer;
+#else
     uint8_t buffer [WARCOMEB_SSD1325Z2_BUFFERDIMENSION];
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_EXTERNAL_BUFFER & defined SSD1325Z2_FIXED_SIZE
+    /** Buffer used by SSD1325Z2_init, with the layout of the external ones */
+    uint8_t bufferData [SSD1325Z2_BUFFER_BYTES(WARCOMEB_SSD1325Z2_WIDTH,WARCOMEB_SSD1325Z2_HEIGHT)];
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_FRAMES
+#if !defined WARCOMEB_SSD1325Z2_USE_EXTERNAL_BUFFER
+    uint8_t frameData [SSD1325Z2_FRAMES][WARCOMEB_SSD1325Z2_BUFFERDIMENSION];
+#endif
+    uint8_t* frames [SSD1325Z2_FRAMES];
+    uint8_t frameRender;         /**< Frame of the buffer, used by drawing */
+    uint8_t frameDisplay;      /**< Frame sent by the last SSD1325Z2_flushFrame */
+    /** Newest frame, with SSD1325Z2_FRAME_FRESH when it isn't displayed */
+    volatile uint8_t frameReady;
+#endif
+
+    /** Areas of the buffer changed after the last flush */
+    SSD1325Z2_Rect dirty [WARCOMEB_SSD1325Z2_DIRTY_RECTANGLES];
+    uint8_t dirtyCount;                  /**< Number of valid dirty areas */
+
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+    /** Copy of the data sent to the display */
+#if defined WARCOMEB_SSD1325Z2_USE_EXTERNAL_BUFFER
+    uint8_t* shadow;
+#else
+    uint8_t shadow [WARCOMEB_SSD1325Z2_BUFFERDIMENSION];
+#endif
+    bool isShadowValid;           /**< TRUE when shadow matches the display */
+#endif
 
 } SSD1325Z2_Device, *SSD1325Z2_DeviceHandle;
 
+#if defined SSD1325Z2_FIXED_SIZE
+#if defined WARCOMEB_GDL_PARALLEL | defined WARCOMEB_GDL_I2C | defined WARCOMEB_GDL_SPI
 /**
+ * The function initializes the device and the display, with the interface
+ * selected for GDL. The parallel interface writes every data pin by itself,
+ * until SSD1325Z2_setParallelPort is called.
  *
+ * @param[in] dev The handle of the device
  */
 void SSD1325Z2_init (SSD1325Z2_DeviceHandle dev);
+#endif
+
+/**
+ * The function initializes the device like SSD1325Z2_init, but it returns
+ * just after the display on: the setup of the display is sent by
+ * SSD1325Z2_initPoll when the power-up delay is elapsed.
+ * The buffer can be drawn at once, but nothing can be sent to the display
+ * until SSD1325Z2_initPoll returns TRUE.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] busOps The operations of the bus connected to the display,
+ *            NULL to use the interface selected for GDL
+ * @param[in] bus The argument passed to every bus operation
+ * @param[in] now The current time in milliseconds
+ */
+void SSD1325Z2_initStart (SSD1325Z2_DeviceHandle dev,
+                          const SSD1325Z2_BusOps* busOps,
+                          void* bus,
+                          uint32_t now);
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_EXTERNAL_BUFFER
+/**
+ * The function initializes the device and the display, with the size of the
+ * display and the buffer given by the user, like SSD1325Z2_init.
+ * The buffer must hold SSD1325Z2_BUFFER_BYTES(width,height) bytes: with the
+ * shadow buffer, its second half is used as shadow.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] width The width of the display, even and between 16 and 128
+ * @param[in] height The height of the display, between 16 and 80
+ * @param[in] buffer The buffer of the display
+ * @return GDL_ERRORS_WRONG_VALUE if the size is not valid or the buffer is
+ *         NULL, GDL_ERRORS_OK otherwise.
+ */
+#if defined WARCOMEB_GDL_PARALLEL | defined WARCOMEB_GDL_I2C | defined WARCOMEB_GDL_SPI
+GDL_Errors SSD1325Z2_initWithBuffer (SSD1325Z2_DeviceHandle dev,
+                                     uint8_t width,
+                                     uint8_t height,
+                                     uint8_t* buffer);
+#endif
+
+/**
+ * The function initializes the device like SSD1325Z2_initWithBuffer, but it
+ * returns just after the display on: the setup of the display is sent by
+ * SSD1325Z2_initPoll when the power-up delay is elapsed.
+ * The buffer can be drawn at once, but nothing can be sent to the display
+ * until SSD1325Z2_initPoll returns TRUE.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] width The width of the display, even and between 16 and 128
+ * @param[in] height The height of the display, between 16 and 80
+ * @param[in] buffer The buffer of the display
+ * @param[in] busOps The operations of the bus connected to the display,
+ *            NULL to use the interface selected for GDL
+ * @param[in] bus The argument passed to every bus operation
+ * @param[in] now The current time in milliseconds
+ * @return GDL_ERRORS_WRONG_VALUE if the size is not valid or the buffer is
+ *         NULL, GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_initWithBufferStart (SSD1325Z2_DeviceHandle dev,
+                                          uint8_t width,
+                                          uint8_t height,
+                                          uint8_t* buffer,
+                                          const SSD1325Z2_BusOps* busOps,
+                                          void* bus,
+                                          uint32_t now);
+#endif
+
+#if defined WARCOMEB_GDL_PARALLEL
+/**
+ * The function makes the parallel interface write the data pins with a
+ * single store into the data port, after the initialization. The masks of
+ * the port are computed from the pins of the description.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] port The description of the data port
+ * @return GDL_ERRORS_WRONG_VALUE if the port has no set register or no pin,
+ *         or if it has no clear register and a pin is after bit 15,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_setParallelPort (SSD1325Z2_DeviceHandle dev,
+                                      const SSD1325Z2_ParallelPort* port);
+#endif
+
+/**
+ * The function goes on with the initialization started by
+ * SSD1325Z2_initStart or SSD1325Z2_initWithBufferStart: when the power-up
+ * delay is elapsed, it sends the setup of the product in a single burst.
+ * The time can wrap around.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] now The current time in milliseconds
+ * @return TRUE when the display is ready, FALSE while the delay is running.
+ */
+bool SSD1325Z2_initPoll (SSD1325Z2_DeviceHandle dev, uint32_t now);
 
 /**
  *
@@ -148,7 +718,7 @@ void SSD1325Z2_drawLine (SSD1325Z2_DeviceHandle dev,
 
 /**
  * The function print a horizontal line from the selected position with
- * the selected width and color.
+ * the selected width and color. The line is clipped to the display.
  *
  * @param[in] dev The handle of the device
  * @param[in] xStart The starting x position
@@ -164,7 +734,7 @@ void SSD1325Z2_drawHLine (SSD1325Z2_DeviceHandle dev,
 
 /**
  * The function print a vertical line from the selected position with
- * the selected height and color.
+ * the selected height and color. The line is clipped to the display.
  *
  * @param[in] dev The handle of the device
  * @param[in] xStart The starting x position
@@ -180,12 +750,13 @@ void SSD1325Z2_drawVLine (SSD1325Z2_DeviceHandle dev,
 
 /**
  * The function draw a rectangle. It can be fill or not.
+ * The rectangle is clipped to the display.
  *
  * @param[in] dev The handle of the device
  * @param[in] xStart The starting x position
  * @param[in] yStart The starting y position
- * @param[in] width The ending x position
- * @param[in] height The ending y position
+ * @param[in] width The width of the rectangle, in pixels
+ * @param[in] height The height of the rectangle, in pixels
  * @param[in] color The color of the rectangle
  * @param[in] isFill If TRUE the rectangle will be fill
  */
@@ -197,6 +768,62 @@ void SSD1325Z2_drawRectangle (SSD1325Z2_DeviceHandle dev,
 							  SSD1325Z2_GrayScale color,
                               bool isFill);
 
+/**
+ * The function draws an antialiased line: every pixel near the line is
+ * blended with the color by its distance from the line, so the 16 levels of
+ * the display smooth the steps.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The starting x position
+ * @param[in] yStart The starting y position
+ * @param[in] xStop The ending x position
+ * @param[in] yStop The ending y position
+ * @param[in] color The color of the line
+ */
+void SSD1325Z2_drawAntialiasedLine (SSD1325Z2_DeviceHandle dev,
+                                    uint8_t xStart,
+                                    uint8_t yStart,
+                                    uint8_t xStop,
+                                    uint8_t yStop,
+                                    SSD1325Z2_GrayScale color);
+
+/**
+ * The function draws an antialiased circle, blending the color into the
+ * pixels near the circle.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xCenter The x position of the center
+ * @param[in] yCenter The y position of the center
+ * @param[in] radius The radius of the circle
+ * @param[in] color The color of the circle
+ */
+void SSD1325Z2_drawAntialiasedCircle (SSD1325Z2_DeviceHandle dev,
+                                      uint8_t xCenter,
+                                      uint8_t yCenter,
+                                      uint8_t radius,
+                                      SSD1325Z2_GrayScale color);
+
+/**
+ * The function draws an antialiased line with square ends and the selected
+ * thickness. The pixels inside the line are filled, the ones on its edges
+ * are blended with the color by their coverage.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The starting x position
+ * @param[in] yStart The starting y position
+ * @param[in] xStop The ending x position
+ * @param[in] yStop The ending y position
+ * @param[in] thickness The thickness of the line, in pixels
+ * @param[in] color The color of the line
+ */
+void SSD1325Z2_drawThickLine (SSD1325Z2_DeviceHandle dev,
+                              uint8_t xStart,
+                              uint8_t yStart,
+                              uint8_t xStop,
+                              uint8_t yStop,
+                              uint8_t thickness,
+                              SSD1325Z2_GrayScale color);
+
 /**
  * The function print a char in the selected position with the selected
  * color and size.
@@ -211,6 +838,11 @@ void SSD1325Z2_drawRectangle (SSD1325Z2_DeviceHandle dev,
  * @param[in] size The size for the char, if 0 use default dimension
  * @return GDL_ERRORS_WRONG_POSITION if the dimension plus position of the char
  *         exceeds the width or height of the display, GDL_ERRORS_OK otherwise.
+ *
+ * @note With the glyph cache, every char of the default font is drawn by GDL
+ *       only once for each combination of colors and size, and then copied
+ *       into the buffer by rows. With the bands, only the chars drawn all
+ *       inside a band are saved into the cache.
  */
 GDL_Errors SSD1325Z2_drawChar (SSD1325Z2_DeviceHandle dev,
                                uint16_t xPos,
@@ -220,6 +852,16 @@ GDL_Errors SSD1325Z2_drawChar (SSD1325Z2_DeviceHandle dev,
                                SSD1325Z2_GrayScale background,
                                uint8_t size);
 
+#if (WARCOMEB_SSD1325Z2_GLYPH_CACHE_ENTRIES > 0)
+/**
+ * The function empties the glyph cache. It must be called when the font
+ * used by GDL is changed.
+ *
+ * @param[in] dev The handle of the device
+ */
+void SSD1325Z2_clearGlyphCache (SSD1325Z2_DeviceHandle dev);
+#endif
+
 /**
  * The function print a string from the selected position with the selected
  * color and size.
@@ -247,7 +889,7 @@ GDL_Errors SSD1325Z2_drawString (SSD1325Z2_DeviceHandle dev,
  * The function print a picture from an array of pixel, in the selected
  * position.
  * Every pixel can be described from 1 or 4 because this OLED driver accept
- * only 16-level of color.
+ * only 16-level of color. The rows are copied directly into the buffer.
  * The starting point is the top-left corner of the picture.
  *
  * @param[in] dev The handle of the device
@@ -258,9 +900,14 @@ GDL_Errors SSD1325Z2_drawString (SSD1325Z2_DeviceHandle dev,
  * @param[in] picture The array of picture to be printed
  * @param[in] pixelType The number of bit for each pixel. This value represent the
  *                      number of color
- * @return GDL_ERRORS_WRONG_POSITION if the dimension plus position of the picture
- *         exceeds the width or height of the display, GDL_ERRORS_WRONG_VALUE if
- *         some value are wrong, GDL_ERRORS_OK otherwise.
+ * @return GDL_ERRORS_WRONG_POSITION if the position of the picture is outside
+ *         of the display, GDL_ERRORS_WRONG_VALUE if some value are wrong,
+ *         GDL_ERRORS_OK otherwise.
+ *
+ * @note Every row of the picture starts with a new byte, and the left pixel
+ *       is the most significant bit (or nibble) of it. With 1 bit for each
+ *       pixel, 1 is drawn with GRAYSCALE_15 and 0 with GRAYSCALE_0.
+ *       The part of the picture outside of the display is not drawn.
  */
 GDL_Errors SSD1325Z2_drawPicture (SSD1325Z2_DeviceHandle dev,
                                   uint16_t xPos,
@@ -270,13 +917,207 @@ GDL_Errors SSD1325Z2_drawPicture (SSD1325Z2_DeviceHandle dev,
                                   const uint8_t* picture,
                                   GDL_PictureType pixelType);
 
+/**
+ * The function draws an image with 8 bits for each pixel, converting every
+ * pixel to the 16 levels of the display with the selected dithering. The
+ * rows are converted straight into the buffer, one at a time.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xPos The x position
+ * @param[in] yPos The y position
+ * @param[in] width The image dimension along the x axis
+ * @param[in] height The image dimension along the y axis
+ * @param[in] image The pixels of the image, 0 is black and 255 is white
+ * @param[in] stride The bytes between the start of two rows of the image
+ * @param[in] dither The dithering of the conversion
+ * @return GDL_ERRORS_WRONG_POSITION if the position of the image is outside
+ *         of the display, GDL_ERRORS_WRONG_VALUE if the dithering is wrong,
+ *         GDL_ERRORS_OK otherwise.
+ *
+ * @note The part of the image outside of the display is not drawn.
+ */
+GDL_Errors SSD1325Z2_drawGrayImage (SSD1325Z2_DeviceHandle dev,
+                                    uint16_t xPos,
+                                    uint16_t yPos,
+                                    uint16_t width,
+                                    uint16_t height,
+                                    const uint8_t* image,
+                                    uint16_t stride,
+                                    SSD1325Z2_Dither dither);
+
+/**
+ * The function inverts the pixels of an area of the buffer: every level n
+ * becomes 15 - n.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] area The area, NULL for the whole display
+ * @return GDL_ERRORS_WRONG_POSITION if the area is outside of the display,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_invertArea (SSD1325Z2_DeviceHandle dev, const SSD1325Z2_Rect* area);
+
+/**
+ * The function adds a level to the pixels of an area of the buffer, up to
+ * GRAYSCALE_15. Useful for fade in.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] area The area, NULL for the whole display
+ * @param[in] level The level to add, from 0 to 15
+ * @return GDL_ERRORS_WRONG_POSITION if the area is outside of the display,
+ *         GDL_ERRORS_WRONG_VALUE if the level is wrong, GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_addArea (SSD1325Z2_DeviceHandle dev,
+                              const SSD1325Z2_Rect* area,
+                              uint8_t level);
+
+/**
+ * The function subtracts a level from the pixels of an area of the buffer,
+ * down to GRAYSCALE_0. Useful for fade out.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] area The area, NULL for the whole display
+ * @param[in] level The level to subtract, from 0 to 15
+ * @return GDL_ERRORS_WRONG_POSITION if the area is outside of the display,
+ *         GDL_ERRORS_WRONG_VALUE if the level is wrong, GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_subtractArea (SSD1325Z2_DeviceHandle dev,
+                                   const SSD1325Z2_Rect* area,
+                                   uint8_t level);
+
+/**
+ * The function scales the pixels of an area of the buffer: every level n
+ * becomes n * level / 15, rounded down.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] area The area, NULL for the whole display
+ * @param[in] level The brightness, from 0 (black) to 15 (unchanged)
+ * @return GDL_ERRORS_WRONG_POSITION if the area is outside of the display,
+ *         GDL_ERRORS_WRONG_VALUE if the level is wrong, GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_scaleArea (SSD1325Z2_DeviceHandle dev,
+                                const SSD1325Z2_Rect* area,
+                                uint8_t level);
+
+/**
+ * The function blends the pixels of an area of the buffer with the same
+ * pixels of a picture: every level n becomes
+ * (n * (15 - level) + p * level) / 15, rounded down. Useful for crossfade.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] area The area, NULL for the whole display
+ * @param[in] picture The whole display with the layout of the buffer, for
+ *                    example the buffer of another frame
+ * @param[in] level The weight of the picture, from 0 (unchanged) to 15
+ *                  (the picture)
+ * @return GDL_ERRORS_WRONG_POSITION if the area is outside of the display,
+ *         GDL_ERRORS_WRONG_VALUE if a value is wrong, GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_blendArea (SSD1325Z2_DeviceHandle dev,
+                                const SSD1325Z2_Rect* area,
+                                const uint8_t* picture,
+                                uint8_t level);
+
 /**
  * This function clear the display setting off all pixel
+ * With the graphic acceleration, the display is cleared by the controller
+ * with a single command.
  *
  * @param[in] dev The handle of the device
  */
 void SSD1325Z2_clear (SSD1325Z2_DeviceHandle dev);
 
+/**
+ * The function moves an area of the buffer to a new position. The source
+ * area keeps its content where it is not overwritten.
+ * With the graphic acceleration the controller copies the area by itself,
+ * after sending the changes of the source not yet flushed; otherwise the
+ * destination area is marked as changed.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] xStart The starting x position, it must be even
+ * @param[in] yStart The starting y position
+ * @param[in] width The width of the area, it must be even
+ * @param[in] height The height of the area
+ * @param[in] xDest The new x position, it must be even
+ * @param[in] yDest The new y position
+ * @return GDL_ERRORS_WRONG_POSITION if some part of the areas is outside of
+ *         the display, GDL_ERRORS_WRONG_VALUE if a x value or the width is
+ *         odd, GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_moveArea (SSD1325Z2_DeviceHandle dev,
+                               uint8_t xStart,
+                               uint8_t yStart,
+                               uint8_t width,
+                               uint8_t height,
+                               uint8_t xDest,
+                               uint8_t yDest);
+
+/**
+ * The function returns the row of the buffer that holds a row of the display.
+ * The scroll rotates the rows of the buffer like the display RAM, so the
+ * next row of the display is not always a stride after.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] yPos The row of the display, into the current band with bands
+ * @return The first byte of the row into the buffer.
+ */
+uint8_t* SSD1325Z2_getRow (SSD1325Z2_DeviceHandle dev, uint8_t yPos);
+
+#if !defined WARCOMEB_SSD1325Z2_USE_BANDS & !defined WARCOMEB_SSD1325Z2_USE_FRAMES
+/**
+ * The function scrolls up the content of the display, and fills the new rows
+ * at the bottom with a color.
+ * The display RAM and the buffer are used as rings of rows: the new rows are
+ * written where the top rows have been, and the display is rotated with the
+ * start line. No row of the buffer is moved, and only the new rows are sent,
+ * with the changes not yet flushed.
+ * The function isn't available with bands or frames.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] rows The number of rows to scroll
+ * @param[in] color The color of the new rows
+ * @return GDL_ERRORS_WRONG_VALUE if rows is greater than the height of the
+ *         display, GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_scrollUp (SSD1325Z2_DeviceHandle dev,
+                               uint8_t rows,
+                               SSD1325Z2_GrayScale color);
+
+/**
+ * The function prints a line of text at the bottom of the display, like a
+ * terminal: the display is scrolled up of the height of the text, with
+ * SSD1325Z2_scrollUp, and only the new line is sent.
+ * The characters beyond the width of the display are not printed.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] text The line to print, terminated by '\n' or '\0'
+ * @param[in] color The foreground color of the text
+ * @param[in] background The background color of the line
+ * @param[in] size The size of the text, 0 to use the default font size
+ * @return GDL_ERRORS_WRONG_VALUE if the text is higher than the display,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_printLine (SSD1325Z2_DeviceHandle dev,
+                                const uint8_t* text,
+                                SSD1325Z2_GrayScale color,
+                                SSD1325Z2_GrayScale background,
+                                uint8_t size);
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_ACCELERATION
+/**
+ * The function enables or disables the graphic acceleration. When it is
+ * enabled clear, filled rectangles and area moves are executed by the
+ * controller, and the buffer is updated to match the display.
+ * Filled rectangles are shown immediately, the other changes of the buffer
+ * still need a flush.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] isEnabled TRUE to use the graphic acceleration
+ */
+void SSD1325Z2_setAcceleration (SSD1325Z2_DeviceHandle dev, bool isEnabled);
+#endif
+
 /**
  *
  *
@@ -284,6 +1125,129 @@ void SSD1325Z2_clear (SSD1325Z2_DeviceHandle dev);
  */
 void SSD1325Z2_flush (SSD1325Z2_DeviceHandle dev);
 
+/**
+ * The function starts to send all the buffer to the display and returns
+ * immediately, when the bus supports asynchronous transfers. The callback is
+ * called, also from interrupt context, when the last byte is sent.
+ * With WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER the data is sent from the shadow
+ * copy, and the buffer can be changed during the transfer; otherwise the
+ * buffer must not be changed until the callback.
+ * Every other function that uses the bus waits the end of the transfer.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] callback The function to call at the end, it can be NULL
+ * @return GDL_ERRORS_WRONG_VALUE if another transfer is running,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_flushAsync (SSD1325Z2_DeviceHandle dev,
+                                 void (*callback)(SSD1325Z2_DeviceHandle dev));
+
+/**
+ * The function returns TRUE while an asynchronous flush is running.
+ *
+ * @param[in] dev The handle of the device
+ */
+bool SSD1325Z2_isFlushing (SSD1325Z2_DeviceHandle dev);
+
+#if defined WARCOMEB_SSD1325Z2_USE_FRAMES
+/**
+ * The function makes the render frame the newest one, and the drawing
+ * continues on another frame, with a copy of the same content. It never
+ * waits the flush, and a newest frame not yet displayed is dropped.
+ * It must be called by the context that draws.
+ *
+ * @param[in] dev The handle of the device
+ */
+void SSD1325Z2_present (SSD1325Z2_DeviceHandle dev);
+
+/**
+ * The function starts to send the newest frame, when it has not been
+ * displayed yet. The frame is sent asynchronously like SSD1325Z2_flushAsync,
+ * and the callback can call this function again from the interrupt context.
+ * It must be called by the context that flushes, the only one that uses
+ * the bus.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] callback The function called at the end of the transfer, or NULL
+ * @return TRUE if a new frame is being sent, FALSE when there is no new frame
+ *         or the previous transfer is running.
+ */
+bool SSD1325Z2_flushFrame (SSD1325Z2_DeviceHandle dev,
+                           void (*callback)(SSD1325Z2_DeviceHandle dev));
+#endif
+
+/**
+ * The function starts an incremental flush of all the buffer: the buffer is
+ * sent by SSD1325Z2_flushStep, a piece at a time.
+ * The changes of the rows not yet sent are sent with the frame, the others
+ * are marked as usual and need another flush.
+ *
+ * @param[in] dev The handle of the device
+ */
+void SSD1325Z2_flushBegin (SSD1325Z2_DeviceHandle dev);
+
+/**
+ * The function sends the next piece of the incremental flush. If another
+ * flush has changed the window of the display, the window is set again and
+ * the current row is sent from its start.
+ * A full flush ends the incremental flush.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] maxBytes The maximum number of data bytes to send
+ * @return TRUE when all the frame has been sent, FALSE otherwise.
+ */
+bool SSD1325Z2_flushStep (SSD1325Z2_DeviceHandle dev, uint16_t maxBytes);
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+/**
+ * The function draws the display one band at a time: for every band the
+ * buffer is cleared, the draw callback is called and the band is sent.
+ * The drawing functions are clipped to the rows of the current band, so the
+ * callback must draw the whole frame every time. The flush functions send
+ * the rows of the current band only.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] draw The function that draws the frame, NULL to clear the display
+ * @param[in] argument The argument passed to the draw function
+ */
+void SSD1325Z2_renderBands (SSD1325Z2_DeviceHandle dev,
+                            void (*draw)(SSD1325Z2_DeviceHandle dev, void* argument),
+                            void* argument);
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+/**
+ * The function starts the recording of a display list: until the commit,
+ * SSD1325Z2_drawRectangle, SSD1325Z2_drawLine, SSD1325Z2_drawHLine,
+ * SSD1325Z2_drawVLine, SSD1325Z2_drawString, SSD1325Z2_drawPicture and
+ * SSD1325Z2_clear are stored into the list instead of drawn.
+ * Every other function that changes the buffer is rejected while recording,
+ * because it would draw out of the order of the list: it draws nothing,
+ * returns GDL_ERRORS_WRONG_VALUE when it returns an error, and the commit
+ * returns GDL_ERRORS_WRONG_VALUE.
+ * The pictures and the font must not change before the commit, and the
+ * errors of the strings outside of the display are not returned.
+ *
+ * @param[in] dev The handle of the device
+ */
+void SSD1325Z2_beginList (SSD1325Z2_DeviceHandle dev);
+
+/**
+ * The function stops the recording, draws the display list and sends it.
+ * The operations completely covered by a following filled rectangle or
+ * picture are dropped. With the bands every band is drawn once, with the
+ * operations on its rows, and the whole display is sent; otherwise the
+ * list is drawn into the buffer and the changes are sent.
+ * Without the bands, a full list is drawn to make room, and the recording
+ * goes on; with the bands, the operations that don't find room are lost.
+ *
+ * @param[in] dev The handle of the device
+ * @return GDL_ERRORS_WRONG_VALUE if some operations were lost or rejected,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_commitList (SSD1325Z2_DeviceHandle dev);
+#endif
+
 /**
  *
  *
@@ -299,6 +1263,37 @@ void SSD1325Z2_flushPart (SSD1325Z2_DeviceHandle dev,
                           uint8_t yStart,
                           uint8_t yStop);
 
+/**
+ * The function sends to the display only the areas of the buffer changed
+ * after the last flush, and then clears the damage.
+ * Every pixel written with @ref SSD1325Z2_drawPixel, directly or from the
+ * drawing primitives, marks its area as changed.
+ *
+ * @param[in] dev The handle of the device
+ */
+void SSD1325Z2_flushDirty (SSD1325Z2_DeviceHandle dev);
+
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+/**
+ * The function compares the buffer with the data already sent to the display
+ * and sends only the changed column span of each row. Near spans are packed
+ * into a single window when it costs less than the commands of a new one.
+ * Before the first complete flush the whole buffer is sent.
+ *
+ * @param[in] dev The handle of the device
+ */
+void SSD1325Z2_flushChanges (SSD1325Z2_DeviceHandle dev);
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_STATISTICS
+/**
+ * The function clears the statistics of the device.
+ *
+ * @param[in] dev The handle of the device
+ */
+void SSD1325Z2_resetStatistics (SSD1325Z2_DeviceHandle dev);
+#endif
+
 /**
  * The function switch on the display.
  *
@@ -324,5 +1319,30 @@ void SSD1325Z2_displayOff (SSD1325Z2_DeviceHandle dev);
  */
 GDL_Errors SSD1325Z2_setContrast (SSD1325Z2_DeviceHandle dev, uint8_t value);
 
+/**
+ * The function loads the gray scale table of the display: the pulse width of
+ * every level from GS1 to GS15, in display clocks. GS0 has no pulse.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] pulses The 15 pulse widths, each one not shorter than the
+ *                   previous one and at most 7 clocks longer
+ * @return GDL_ERRORS_WRONG_VALUE if a pulse width can't be set,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_setGrayTable (SSD1325Z2_DeviceHandle dev, const uint8_t* pulses);
+
+/**
+ * The function loads a gray scale table with the selected gamma: the
+ * brightness of the level n is (n/15)^gamma. The table uses the longest
+ * pulses the display allows, and every level stays brighter than the
+ * previous one.
+ *
+ * @param[in] dev The handle of the device
+ * @param[in] gamma The gamma in tenths, from 5 to 40 (22 for a gamma of 2.2)
+ * @return GDL_ERRORS_WRONG_VALUE if the gamma is out of range,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_setGamma (SSD1325Z2_DeviceHandle dev, uint8_t gamma);
+
 #endif /* __WARCOMEB_SSD1325Z2_H */
 
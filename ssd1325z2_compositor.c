@@ -0,0 +1,362 @@
+/******************************************************************************
+ * SSD1325Z2 - Library for SSD1325Z2 OLed Driver based on libohiboard
+ * Copyright (C) 2018 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include "ssd1325z2_compositor.h"
+
+#include <string.h>
+
+/**
+ * The function returns the pixels of the union of two areas, minus the ones
+ * of the first area.
+ */
+static uint16_t SSD1325Z2_Compositor_growth (const SSD1325Z2_Rect* rect, const SSD1325Z2_Rect* area)
+{
+    uint8_t xStart = (area->xStart < rect->xStart) ? area->xStart : rect->xStart;
+    uint8_t xStop = (area->xStop > rect->xStop) ? area->xStop : rect->xStop;
+    uint8_t yStart = (area->yStart < rect->yStart) ? area->yStart : rect->yStart;
+    uint8_t yStop = (area->yStop > rect->yStop) ? area->yStop : rect->yStop;
+
+    return (uint16_t)(xStop - xStart + 1) * (yStop - yStart + 1) -
+           (uint16_t)(rect->xStop - rect->xStart + 1) * (rect->yStop - rect->yStart + 1);
+}
+
+static void SSD1325Z2_Compositor_merge (SSD1325Z2_Rect* rect, const SSD1325Z2_Rect* area)
+{
+    if (area->xStart < rect->xStart) rect->xStart = area->xStart;
+    if (area->xStop > rect->xStop) rect->xStop = area->xStop;
+    if (area->yStart < rect->yStart) rect->yStart = area->yStart;
+    if (area->yStop > rect->yStop) rect->yStop = area->yStop;
+}
+
+/**
+ * The function adds an area to the damage, clipped to the display. The areas
+ * that overlap or touch are merged, so no pixel is composed twice; when
+ * there is no room, the area is merged with the one that grows less.
+ */
+static void SSD1325Z2_Compositor_addDamage (SSD1325Z2_Compositor* compositor,
+                                            int16_t xPos,
+                                            int16_t yPos,
+                                            int16_t width,
+                                            int16_t height)
+{
+    int16_t xStop = xPos + width - 1;
+    int16_t yStop = yPos + height - 1;
+
+    if (xPos < 0) xPos = 0;
+    if (yPos < 0) yPos = 0;
+    if (xStop >= compositor->dev->gdl.width) xStop = compositor->dev->gdl.width - 1;
+    if (yStop >= compositor->dev->gdl.height) yStop = compositor->dev->gdl.height - 1;
+    if ((width <= 0) || (height <= 0) || (xPos > xStop) || (yPos > yStop)) return;
+
+    SSD1325Z2_Rect area = {(uint8_t)xPos, (uint8_t)xStop, (uint8_t)yPos, (uint8_t)yStop};
+
+    for (;;)
+    {
+        for (uint8_t i = 0; i < compositor->damageCount; )
+        {
+            SSD1325Z2_Rect* rect = &compositor->damage[i];
+            if ((rect->xStart > area.xStop + 1) || (rect->xStop + 1 < area.xStart) ||
+                (rect->yStart > area.yStop + 1) || (rect->yStop + 1 < area.yStart))
+            {
+                i++;
+                continue;
+            }
+
+            // The union can touch other areas, so it is checked from the start
+            SSD1325Z2_Compositor_merge(&area,rect);
+            compositor->damage[i] = compositor->damage[--compositor->damageCount];
+            i = 0;
+        }
+
+        if (compositor->damageCount < WARCOMEB_SSD1325Z2_COMPOSITOR_DAMAGE)
+        {
+            compositor->damage[compositor->damageCount++] = area;
+            return;
+        }
+
+        uint16_t bestGrowth = 0xFFFF;
+        uint8_t best = 0;
+        for (uint8_t i = 0; i < compositor->damageCount; i++)
+        {
+            uint16_t growth = SSD1325Z2_Compositor_growth(&compositor->damage[i],&area);
+            if (growth < bestGrowth)
+            {
+                bestGrowth = growth;
+                best = i;
+            }
+        }
+
+        // The union takes the place of that area, and it can reach others
+        SSD1325Z2_Compositor_merge(&area,&compositor->damage[best]);
+        compositor->damage[best] = compositor->damage[--compositor->damageCount];
+    }
+}
+
+static inline void SSD1325Z2_Compositor_damageSprite (SSD1325Z2_Compositor* compositor,
+                                                      const SSD1325Z2_Sprite* sprite)
+{
+    if (sprite->isVisible)
+        SSD1325Z2_Compositor_addDamage(compositor,sprite->xPos,sprite->yPos,sprite->width,sprite->height);
+}
+
+/**
+ * The function copies a sequence of pixels into a row of the buffer, with
+ * the left pixel into the most significant nibble. With a key, the pixels of
+ * that color are skipped; the pixels are copied two at a time, with a mask
+ * of the nibbles to write.
+ *
+ * @param[in] dst The row of the buffer
+ * @param[in] dstX The first pixel to write
+ * @param[in] src The row of the picture
+ * @param[in] srcX The first pixel to copy
+ * @param[in] count The number of pixels
+ * @param[in] key The transparent color, or SSD1325Z2_COMPOSITOR_OPAQUE
+ */
+static void SSD1325Z2_Compositor_blitRow (uint8_t* dst,
+                                          uint16_t dstX,
+                                          const uint8_t* src,
+                                          uint16_t srcX,
+                                          uint16_t count,
+                                          uint8_t key)
+{
+    bool isKeyed = (key != SSD1325Z2_COMPOSITOR_OPAQUE);
+    uint8_t keys = (key & 0x0F) * 0x11;
+    uint8_t pixel;
+
+    if ((count > 0) && (dstX & 1))
+    {
+        pixel = (srcX & 1) ? (src[srcX/2] & 0x0F) : (src[srcX/2] >> 4);
+        if (!isKeyed || (pixel != key))
+            dst[dstX/2] = (dst[dstX/2] & 0xF0) | pixel;
+        dstX++;
+        srcX++;
+        count--;
+    }
+
+    dst += dstX/2;
+    for (; count >= 2; count -= 2, dst++, srcX += 2)
+    {
+        uint8_t pixels = (srcX & 1) ?
+                         (uint8_t)((src[srcX/2] << 4) | (src[srcX/2 + 1] >> 4)) : src[srcX/2];
+        uint8_t mask = 0xFF;
+        if (isKeyed)
+        {
+            // Every nibble different from the key has its lowest bit set
+            mask = pixels ^ keys;
+            mask |= mask >> 1;
+            mask |= mask >> 2;
+            mask = (mask & 0x11) * 0x0F;
+        }
+        *dst = (*dst & ~mask) | (pixels & mask);
+    }
+
+    if (count > 0)
+    {
+        pixel = (srcX & 1) ? (src[srcX/2] & 0x0F) : (src[srcX/2] >> 4);
+        if (!isKeyed || (pixel != key))
+            *dst = (*dst & 0x0F) | (pixel << 4);
+    }
+}
+
+/**
+ * The function redraws an area of the buffer: the background first, and
+ * then the sprites over it, from the lowest z.
+ */
+static void SSD1325Z2_Compositor_redraw (SSD1325Z2_Compositor* compositor,
+                                         const SSD1325Z2_Rect* area,
+                                         const uint8_t* order)
+{
+    SSD1325Z2_DeviceHandle dev = compositor->dev;
+    uint8_t widthHalf = dev->gdl.width/2;
+    uint8_t count = area->xStop - area->xStart + 1;
+
+    for (uint8_t y = area->yStart; y <= area->yStop; y++)
+    {
+        uint8_t* row = SSD1325Z2_getRow(dev,y);
+
+        if (compositor->background != NULL)
+        {
+            SSD1325Z2_Compositor_blitRow(row,area->xStart,&compositor->background[y * widthHalf],
+                                         area->xStart,count,SSD1325Z2_COMPOSITOR_OPAQUE);
+        }
+        else
+        {
+            uint8_t color = compositor->backgroundColor & 0x0F;
+            uint8_t colors = color * 0x11;
+            uint8_t xStart = area->xStart;
+            uint8_t xStop = area->xStop;
+
+            if (xStart & 1)
+                row[xStart/2] = (row[xStart/2] & 0xF0) | color;
+            if (!(xStop & 1))
+                row[xStop/2] = (row[xStop/2] & 0x0F) | (color << 4);
+            xStart = (xStart + 1) / 2;
+            xStop = (xStop + 1) / 2;
+            if (xStop > xStart)
+                memset(&row[xStart],colors,xStop - xStart);
+        }
+    }
+
+    for (uint8_t i = 0; i < compositor->spriteCount; i++)
+    {
+        const SSD1325Z2_Sprite* sprite = &compositor->sprites[order[i]];
+        if (!sprite->isVisible) continue;
+
+        // Part of the sprite into the area
+        int16_t xStart = (sprite->xPos > area->xStart) ? sprite->xPos : area->xStart;
+        int16_t xStop = sprite->xPos + sprite->width - 1;
+        int16_t yStart = (sprite->yPos > area->yStart) ? sprite->yPos : area->yStart;
+        int16_t yStop = sprite->yPos + sprite->height - 1;
+        if (xStop > area->xStop) xStop = area->xStop;
+        if (yStop > area->yStop) yStop = area->yStop;
+        if ((xStart > xStop) || (yStart > yStop)) continue;
+
+        uint8_t stride = (sprite->width + 1)/2;
+        const uint8_t* picture = &sprite->picture[(yStart - sprite->yPos) * stride];
+        for (int16_t y = yStart; y <= yStop; y++, picture += stride)
+        {
+            SSD1325Z2_Compositor_blitRow(SSD1325Z2_getRow(dev,y),xStart,picture,xStart - sprite->xPos,
+                                         xStop - xStart + 1,sprite->key);
+        }
+    }
+}
+
+void SSD1325Z2_Compositor_init (SSD1325Z2_Compositor* compositor,
+                                SSD1325Z2_DeviceHandle dev,
+                                const uint8_t* background,
+                                SSD1325Z2_GrayScale color)
+{
+    compositor->dev = dev;
+    compositor->background = background;
+    compositor->backgroundColor = color;
+    compositor->spriteCount = 0;
+    compositor->damageCount = 0;
+
+    SSD1325Z2_Compositor_addDamage(compositor,0,0,dev->gdl.width,dev->gdl.height);
+}
+
+SSD1325Z2_Sprite* SSD1325Z2_Compositor_add (SSD1325Z2_Compositor* compositor,
+                                            const uint8_t* picture,
+                                            uint8_t width,
+                                            uint8_t height,
+                                            uint8_t z,
+                                            uint8_t key)
+{
+    if ((compositor->spriteCount == WARCOMEB_SSD1325Z2_COMPOSITOR_SPRITES) ||
+        (picture == NULL) || (width == 0) || (height == 0) ||
+        ((key > SSD1325Z2_GRAYSCALE_15) && (key != SSD1325Z2_COMPOSITOR_OPAQUE)))
+        return NULL;
+
+    SSD1325Z2_Sprite* sprite = &compositor->sprites[compositor->spriteCount++];
+    sprite->picture = picture;
+    sprite->width = width;
+    sprite->height = height;
+    sprite->xPos = 0;
+    sprite->yPos = 0;
+    sprite->z = z;
+    sprite->key = key;
+    sprite->isVisible = TRUE;
+
+    SSD1325Z2_Compositor_damageSprite(compositor,sprite);
+    return sprite;
+}
+
+void SSD1325Z2_Compositor_move (SSD1325Z2_Compositor* compositor,
+                                SSD1325Z2_Sprite* sprite,
+                                int16_t xPos,
+                                int16_t yPos)
+{
+    if ((sprite->xPos == xPos) && (sprite->yPos == yPos)) return;
+
+    // The area where it was shows the background again
+    SSD1325Z2_Compositor_damageSprite(compositor,sprite);
+    sprite->xPos = xPos;
+    sprite->yPos = yPos;
+    SSD1325Z2_Compositor_damageSprite(compositor,sprite);
+}
+
+void SSD1325Z2_Compositor_setPicture (SSD1325Z2_Compositor* compositor,
+                                      SSD1325Z2_Sprite* sprite,
+                                      const uint8_t* picture)
+{
+    if ((picture == NULL) || (sprite->picture == picture)) return;
+
+    sprite->picture = picture;
+    SSD1325Z2_Compositor_damageSprite(compositor,sprite);
+}
+
+void SSD1325Z2_Compositor_show (SSD1325Z2_Compositor* compositor,
+                                SSD1325Z2_Sprite* sprite,
+                                bool isVisible)
+{
+    if (sprite->isVisible == isVisible) return;
+
+    // The area is damaged while the sprite is visible
+    if (isVisible)
+    {
+        sprite->isVisible = TRUE;
+        SSD1325Z2_Compositor_damageSprite(compositor,sprite);
+    }
+    else
+    {
+        SSD1325Z2_Compositor_damageSprite(compositor,sprite);
+        sprite->isVisible = FALSE;
+    }
+}
+
+void SSD1325Z2_Compositor_damage (SSD1325Z2_Compositor* compositor,
+                                  int16_t xPos,
+                                  int16_t yPos,
+                                  uint8_t width,
+                                  uint8_t height)
+{
+    SSD1325Z2_Compositor_addDamage(compositor,xPos,yPos,width,height);
+}
+
+void SSD1325Z2_Compositor_compose (SSD1325Z2_Compositor* compositor)
+{
+    if (compositor->damageCount == 0) return;
+
+    // Sprites sorted by z, the first added goes below with the same z
+    uint8_t order [WARCOMEB_SSD1325Z2_COMPOSITOR_SPRITES];
+    for (uint8_t i = 0; i < compositor->spriteCount; i++)
+    {
+        uint8_t j = i;
+        for (; (j > 0) && (compositor->sprites[order[j-1]].z > compositor->sprites[i].z); j--)
+            order[j] = order[j-1];
+        order[j] = i;
+    }
+
+    for (uint8_t i = 0; i < compositor->damageCount; i++)
+    {
+        const SSD1325Z2_Rect* area = &compositor->damage[i];
+
+        SSD1325Z2_Compositor_redraw(compositor,area,order);
+        SSD1325Z2_flushPart(compositor->dev,area->xStart,area->xStop,area->yStart,area->yStop);
+    }
+    compositor->damageCount = 0;
+}
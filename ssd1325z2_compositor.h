@@ -0,0 +1,202 @@
+/******************************************************************************
+ * SSD1325Z2 - Library for SSD1325Z2 OLed Driver based on libohiboard
+ * Copyright (C) 2018 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef __WARCOMEB_SSD1325Z2_COMPOSITOR_H
+#define __WARCOMEB_SSD1325Z2_COMPOSITOR_H
+
+/*
+ * Sprites drawn over a background, with a transparent color. Every change of
+ * a sprite damages the area where it was and the one where it goes; the
+ * compose redraws only the damaged areas, from the background and the
+ * sprites in z order, and sends them with SSD1325Z2_flushPart.
+ * A layer is a sprite as big as the display.
+ *
+ *     SSD1325Z2_Compositor_init(&compositor,&display,background,SSD1325Z2_GRAYSCALE_0);
+ *     cursor = SSD1325Z2_Compositor_add(&compositor,arrow,8,8,1,SSD1325Z2_GRAYSCALE_0);
+ *     ...
+ *     SSD1325Z2_Compositor_move(&compositor,cursor,x,y);
+ *     SSD1325Z2_Compositor_compose(&compositor);
+ */
+
+#include "ssd1325z2.h"
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+#error "The compositor needs the buffer of the whole display!"
+#endif
+
+/*
+ * The user can define the maximum number of sprites, and the number of
+ * damaged areas collected before a compose:
+ *     #define WARCOMEB_SSD1325Z2_COMPOSITOR_SPRITES xx
+ *     #define WARCOMEB_SSD1325Z2_COMPOSITOR_DAMAGE  xx
+ */
+#ifndef WARCOMEB_SSD1325Z2_COMPOSITOR_SPRITES
+#define WARCOMEB_SSD1325Z2_COMPOSITOR_SPRITES 8
+#endif
+
+#ifndef WARCOMEB_SSD1325Z2_COMPOSITOR_DAMAGE
+#define WARCOMEB_SSD1325Z2_COMPOSITOR_DAMAGE 8
+#endif
+
+#if (WARCOMEB_SSD1325Z2_COMPOSITOR_SPRITES < 1) | (WARCOMEB_SSD1325Z2_COMPOSITOR_DAMAGE < 1)
+#error "The compositor needs at least one sprite and one damaged area!"
+#endif
+
+/** Key of the sprites without transparent color */
+#define SSD1325Z2_COMPOSITOR_OPAQUE              0xFF
+
+/**
+ * A picture drawn over the background.
+ */
+typedef struct _SSD1325Z2_Sprite
+{
+    /**
+     * Pixels with 4 bits, every row starts with a new byte and the left pixel
+     * is the most significant nibble, like SSD1325Z2_drawPicture.
+     */
+    const uint8_t* picture;
+    uint8_t width;
+    uint8_t height;
+    int16_t xPos;               /**< Position, it can be outside the display */
+    int16_t yPos;
+    uint8_t z;                       /**< Sprites with higher z are on top */
+    uint8_t key;  /**< Transparent color, or SSD1325Z2_COMPOSITOR_OPAQUE */
+    bool isVisible;
+} SSD1325Z2_Sprite;
+
+typedef struct _SSD1325Z2_Compositor
+{
+    SSD1325Z2_DeviceHandle dev;
+
+    /**
+     * The whole display with the layout of the buffer. When it is NULL, the
+     * background is filled with backgroundColor.
+     */
+    const uint8_t* background;
+    SSD1325Z2_GrayScale backgroundColor;
+
+    SSD1325Z2_Sprite sprites [WARCOMEB_SSD1325Z2_COMPOSITOR_SPRITES];
+    uint8_t spriteCount;                          /**< Number of sprites */
+
+    /** Areas to compose, clipped to the display */
+    SSD1325Z2_Rect damage [WARCOMEB_SSD1325Z2_COMPOSITOR_DAMAGE];
+    uint8_t damageCount;                  /**< Number of damaged areas */
+} SSD1325Z2_Compositor;
+
+/**
+ * The function empties the compositor, and damages the whole display so the
+ * first compose draws all of it.
+ *
+ * @param[in] compositor The compositor
+ * @param[in] dev The handle of the initialized device
+ * @param[in] background The background with the layout of the buffer, or NULL
+ * @param[in] color The color of the background when the picture is NULL
+ */
+void SSD1325Z2_Compositor_init (SSD1325Z2_Compositor* compositor,
+                                SSD1325Z2_DeviceHandle dev,
+                                const uint8_t* background,
+                                SSD1325Z2_GrayScale color);
+
+/**
+ * The function adds a visible sprite at the top left corner of the display.
+ *
+ * @param[in] compositor The compositor
+ * @param[in] picture The pixels of the sprite
+ * @param[in] width The width of the sprite
+ * @param[in] height The height of the sprite
+ * @param[in] z The order of the sprite, higher is on top
+ * @param[in] key The transparent color, or SSD1325Z2_COMPOSITOR_OPAQUE
+ * @return The sprite, NULL when there is no room or a value is wrong.
+ */
+SSD1325Z2_Sprite* SSD1325Z2_Compositor_add (SSD1325Z2_Compositor* compositor,
+                                            const uint8_t* picture,
+                                            uint8_t width,
+                                            uint8_t height,
+                                            uint8_t z,
+                                            uint8_t key);
+
+/**
+ * The function moves a sprite.
+ *
+ * @param[in] compositor The compositor
+ * @param[in] sprite The sprite
+ * @param[in] xPos The new x position
+ * @param[in] yPos The new y position
+ */
+void SSD1325Z2_Compositor_move (SSD1325Z2_Compositor* compositor,
+                                SSD1325Z2_Sprite* sprite,
+                                int16_t xPos,
+                                int16_t yPos);
+
+/**
+ * The function changes the pixels of a sprite, with the same size, for
+ * example the next frame of an animation.
+ *
+ * @param[in] compositor The compositor
+ * @param[in] sprite The sprite
+ * @param[in] picture The new pixels
+ */
+void SSD1325Z2_Compositor_setPicture (SSD1325Z2_Compositor* compositor,
+                                      SSD1325Z2_Sprite* sprite,
+                                      const uint8_t* picture);
+
+/**
+ * The function shows or hides a sprite.
+ *
+ * @param[in] compositor The compositor
+ * @param[in] sprite The sprite
+ * @param[in] isVisible TRUE to show the sprite
+ */
+void SSD1325Z2_Compositor_show (SSD1325Z2_Compositor* compositor,
+                                SSD1325Z2_Sprite* sprite,
+                                bool isVisible);
+
+/**
+ * The function damages an area, for example after a change of the
+ * background. The area is clipped to the display.
+ *
+ * @param[in] compositor The compositor
+ * @param[in] xPos The x position of the area
+ * @param[in] yPos The y position of the area
+ * @param[in] width The width of the area
+ * @param[in] height The height of the area
+ */
+void SSD1325Z2_Compositor_damage (SSD1325Z2_Compositor* compositor,
+                                  int16_t xPos,
+                                  int16_t yPos,
+                                  uint8_t width,
+                                  uint8_t height);
+
+/**
+ * The function redraws the damaged areas into the buffer, and sends them to
+ * the display.
+ *
+ * @param[in] compositor The compositor
+ */
+void SSD1325Z2_Compositor_compose (SSD1325Z2_Compositor* compositor);
+
+#endif /* __WARCOMEB_SSD1325Z2_COMPOSITOR_H */
@@ -0,0 +1,180 @@
+/******************************************************************************
+ * SSD1325Z2 - Library for SSD1325Z2 OLed Driver based on libohiboard
+ * Copyright (C) 2018 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include "ssd1325z2_group.h"
+
+/**
+ * The function returns the bytes of a row of an area.
+ */
+static inline uint16_t SSD1325Z2_Group_rowBytes (const SSD1325Z2_Rect* area)
+{
+    return (area->xStop/2) - (area->xStart/2) + 1;
+}
+
+/**
+ * The function returns the bytes of data of an area.
+ */
+static inline uint16_t SSD1325Z2_Group_areaBytes (const SSD1325Z2_Rect* area)
+{
+    return SSD1325Z2_Group_rowBytes(area) * (uint16_t)(area->yStop - area->yStart + 1);
+}
+
+/**
+ * The function adds an area of a display to the queue, merged into a job of
+ * the same display when they overlap.
+ *
+ * @return FALSE if the queue is full, TRUE otherwise.
+ */
+static bool SSD1325Z2_Group_addJob (SSD1325Z2_Group* group,
+                                    SSD1325Z2_DeviceHandle dev,
+                                    const SSD1325Z2_Rect* area,
+                                    bool isUrgent)
+{
+    for (uint8_t i = 0; i < group->jobCount; i++)
+    {
+        SSD1325Z2_GroupJob* job = &group->jobs[i];
+        if ((job->dev != dev) ||
+            (job->area.xStart > area->xStop) || (job->area.xStop < area->xStart) ||
+            (job->area.yStart > area->yStop) || (job->area.yStop < area->yStart))
+            continue;
+
+        if (area->xStart < job->area.xStart) job->area.xStart = area->xStart;
+        if (area->xStop > job->area.xStop) job->area.xStop = area->xStop;
+        if (area->yStart < job->area.yStart) job->area.yStart = area->yStart;
+        if (area->yStop > job->area.yStop) job->area.yStop = area->yStop;
+        job->isUrgent |= isUrgent;
+        return TRUE;
+    }
+
+    if (group->jobCount == WARCOMEB_SSD1325Z2_GROUP_JOBS) return FALSE;
+
+    SSD1325Z2_GroupJob* job = &group->jobs[group->jobCount++];
+    job->dev = dev;
+    job->area = *area;
+    job->isUrgent = isUrgent;
+    return TRUE;
+}
+
+void SSD1325Z2_Group_init (SSD1325Z2_Group* group)
+{
+    group->panelCount = 0;
+    group->jobCount = 0;
+}
+
+GDL_Errors SSD1325Z2_Group_add (SSD1325Z2_Group* group, SSD1325Z2_DeviceHandle dev)
+{
+    if (group->panelCount == WARCOMEB_SSD1325Z2_GROUP_PANELS)
+        return GDL_ERRORS_WRONG_VALUE;
+
+    group->panels[group->panelCount++] = dev;
+    return GDL_ERRORS_OK;
+}
+
+GDL_Errors SSD1325Z2_Group_queue (SSD1325Z2_Group* group,
+                                  SSD1325Z2_DeviceHandle dev,
+                                  bool isUrgent)
+{
+    uint8_t i = 0;
+    while ((i < group->panelCount) && (group->panels[i] != dev)) i++;
+    if (i == group->panelCount) return GDL_ERRORS_WRONG_VALUE;
+
+    // The areas that don't find room stay into the display
+    uint8_t j = 0;
+    for (i = 0; i < dev->dirtyCount; i++)
+    {
+        if (!SSD1325Z2_Group_addJob(group,dev,&dev->dirty[i],isUrgent))
+            dev->dirty[j++] = dev->dirty[i];
+    }
+    dev->dirtyCount = j;
+
+    return GDL_ERRORS_OK;
+}
+
+bool SSD1325Z2_Group_step (SSD1325Z2_Group* group)
+{
+    if (group->jobCount == 0) return FALSE;
+
+    // Urgent jobs first, then the shortest one
+    uint8_t next = 0;
+    uint16_t nextBytes = SSD1325Z2_Group_areaBytes(&group->jobs[0].area);
+    for (uint8_t i = 1; i < group->jobCount; i++)
+    {
+        const SSD1325Z2_GroupJob* job = &group->jobs[i];
+        uint16_t bytes = SSD1325Z2_Group_areaBytes(&job->area);
+
+        if (job->isUrgent != group->jobs[next].isUrgent)
+        {
+            if (!job->isUrgent) continue;
+        }
+        else if (bytes >= nextBytes)
+        {
+            continue;
+        }
+        next = i;
+        nextBytes = bytes;
+    }
+
+    SSD1325Z2_GroupJob* job = &group->jobs[next];
+    uint16_t rows = WARCOMEB_SSD1325Z2_GROUP_CHUNK_BYTES / SSD1325Z2_Group_rowBytes(&job->area);
+    if (rows == 0) rows = 1;
+
+    if (job->area.yStart + rows > job->area.yStop)
+    {
+        // Last chunk of the job
+        SSD1325Z2_flushPart(job->dev,job->area.xStart,job->area.xStop,job->area.yStart,job->area.yStop);
+
+        group->jobCount--;
+        for (uint8_t i = next; i < group->jobCount; i++)
+            group->jobs[i] = group->jobs[i + 1];
+    }
+    else
+    {
+        SSD1325Z2_flushPart(job->dev,job->area.xStart,job->area.xStop,job->area.yStart,job->area.yStart + rows - 1);
+        job->area.yStart += rows;
+    }
+
+    return (group->jobCount > 0);
+}
+
+void SSD1325Z2_Group_flush (SSD1325Z2_Group* group)
+{
+    bool isQueued;
+
+    do
+    {
+        // The changes that didn't find room are queued at the next round
+        isQueued = FALSE;
+        for (uint8_t i = 0; i < group->panelCount; i++)
+        {
+            SSD1325Z2_Group_queue(group,group->panels[i],FALSE);
+            isQueued |= (group->panels[i]->dirtyCount > 0);
+        }
+
+        while (SSD1325Z2_Group_step(group));
+    }
+    while (isQueued);
+}
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * SSD1325Z2 - Library for SSD1325Z2 OLed Driver based on libohiboard
+ * Copyright (C) 2018 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef __WARCOMEB_SSD1325Z2_GROUP_H
+#define __WARCOMEB_SSD1325Z2_GROUP_H
+
+/*
+ * Group of displays that share the same bus, every one with its own chip
+ * select. The changes of all the displays are collected into one queue of
+ * jobs, and the jobs are sent in chunks of rows: the job with less bytes to
+ * send goes first, and the urgent jobs go before all the others. So a small
+ * change of a display is not delayed by a full update of another one.
+ *
+ *     SSD1325Z2_Group_init(&group);
+ *     SSD1325Z2_Group_add(&group,&display1);
+ *     SSD1325Z2_Group_add(&group,&display2);
+ *     ...
+ *     SSD1325Z2_Group_queue(&group,&display2,TRUE);
+ *     while (SSD1325Z2_Group_step(&group))
+ *         ...
+ */
+
+#include "ssd1325z2.h"
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+#error "The group needs the buffer of the whole display!"
+#endif
+
+/*
+ * The user can define the maximum number of displays into a group, the
+ * number of jobs into the queue, and the bytes of data sent with a step:
+ *     #define WARCOMEB_SSD1325Z2_GROUP_PANELS      xx
+ *     #define WARCOMEB_SSD1325Z2_GROUP_JOBS        xx
+ *     #define WARCOMEB_SSD1325Z2_GROUP_CHUNK_BYTES xx
+ */
+#ifndef WARCOMEB_SSD1325Z2_GROUP_PANELS
+#define WARCOMEB_SSD1325Z2_GROUP_PANELS 3
+#endif
+
+#ifndef WARCOMEB_SSD1325Z2_GROUP_JOBS
+#define WARCOMEB_SSD1325Z2_GROUP_JOBS 8
+#endif
+
+#ifndef WARCOMEB_SSD1325Z2_GROUP_CHUNK_BYTES
+#define WARCOMEB_SSD1325Z2_GROUP_CHUNK_BYTES 256
+#endif
+
+#if (WARCOMEB_SSD1325Z2_GROUP_PANELS < 1) | (WARCOMEB_SSD1325Z2_GROUP_JOBS < 1)
+#error "The group needs at least one display and one job!"
+#endif
+
+/**
+ * An area of a display waiting to be sent.
+ */
+typedef struct _SSD1325Z2_GroupJob
+{
+    SSD1325Z2_DeviceHandle dev;
+    SSD1325Z2_Rect area;                /**< Part of the area not yet sent */
+    bool isUrgent;                        /**< TRUE to send it before others */
+} SSD1325Z2_GroupJob;
+
+typedef struct _SSD1325Z2_Group
+{
+    SSD1325Z2_DeviceHandle panels [WARCOMEB_SSD1325Z2_GROUP_PANELS];
+    uint8_t panelCount;                         /**< Number of displays */
+
+    /** Jobs waiting, from the oldest */
+    SSD1325Z2_GroupJob jobs [WARCOMEB_SSD1325Z2_GROUP_JOBS];
+    uint8_t jobCount;                               /**< Number of jobs */
+} SSD1325Z2_Group;
+
+/**
+ * The function empties the group.
+ *
+ * @param[in] group The group
+ */
+void SSD1325Z2_Group_init (SSD1325Z2_Group* group);
+
+/**
+ * The function adds an initialized display to the group.
+ *
+ * @param[in] group The group
+ * @param[in] dev The handle of the device
+ * @return GDL_ERRORS_WRONG_VALUE if the group is full, GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_Group_add (SSD1325Z2_Group* group, SSD1325Z2_DeviceHandle dev);
+
+/**
+ * The function moves the changes of a display into the queue. An area that
+ * overlaps a job of the same display is merged into it. When the queue is
+ * full, the remaining changes stay into the display and can be queued later.
+ *
+ * @param[in] group The group
+ * @param[in] dev The handle of the device
+ * @param[in] isUrgent TRUE to send the changes before the others
+ * @return GDL_ERRORS_WRONG_VALUE if the display is not into the group,
+ *         GDL_ERRORS_OK otherwise.
+ */
+GDL_Errors SSD1325Z2_Group_queue (SSD1325Z2_Group* group,
+                                  SSD1325Z2_DeviceHandle dev,
+                                  bool isUrgent);
+
+/**
+ * The function sends a chunk of the next job, about
+ * WARCOMEB_SSD1325Z2_GROUP_CHUNK_BYTES bytes of data and at least one row.
+ * The next job is the urgent one, or the one with less bytes to send; with
+ * the same bytes, the oldest.
+ *
+ * @param[in] group The group
+ * @return TRUE while there are jobs to send.
+ */
+bool SSD1325Z2_Group_step (SSD1325Z2_Group* group);
+
+/**
+ * The function queues the changes of all the displays, and sends all of them.
+ *
+ * @param[in] group The group
+ */
+void SSD1325Z2_Group_flush (SSD1325Z2_Group* group);
+
+#endif /* __WARCOMEB_SSD1325Z2_GROUP_H */
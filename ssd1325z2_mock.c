@@ -0,0 +1,74 @@
+/******************************************************************************
+ * SSD1325Z2 - Library for SSD1325Z2 OLed Driver based on libohiboard
+ * Copyright (C) 2018 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include "ssd1325z2_mock.h"
+
+#include <string.h>
+
+/** D/C# bit of the I2C control byte */
+#define SSD1325Z2_MOCK_CONTROL_DATA              0x40
+
+void SSD1325Z2_MockI2c_reset (SSD1325Z2_MockI2c* mock)
+{
+    mock->transactions = 0;
+    mock->busBytes = 0;
+    mock->commandBytes = 0;
+    mock->dataBytes = 0;
+    mock->longestTransaction = 0;
+    mock->lastAddress = 0;
+    mock->captureLength = 0;
+}
+
+void SSD1325Z2_MockI2c_write (void* context,
+                              uint8_t address,
+                              uint8_t control,
+                              const uint8_t* data,
+                              uint16_t length)
+{
+    SSD1325Z2_MockI2c* mock = (SSD1325Z2_MockI2c*)context;
+
+    mock->transactions++;
+    // Address and control byte, then the payload
+    mock->busBytes += 2 + length;
+    mock->lastAddress = address;
+    if (length > mock->longestTransaction)
+        mock->longestTransaction = length;
+
+    if (control & SSD1325Z2_MOCK_CONTROL_DATA)
+        mock->dataBytes += length;
+    else
+        mock->commandBytes += length;
+
+    if (mock->capture != NULL)
+    {
+        uint32_t room = mock->captureSize - mock->captureLength;
+        uint32_t size = (length > room) ? room : length;
+
+        memcpy(&mock->capture[mock->captureLength],data,size);
+        mock->captureLength += size;
+    }
+}
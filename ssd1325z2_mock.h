@@ -0,0 +1,78 @@
+/******************************************************************************
+ * SSD1325Z2 - Library for SSD1325Z2 OLed Driver based on libohiboard
+ * Copyright (C) 2018 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef __WARCOMEB_SSD1325Z2_MOCK_H
+#define __WARCOMEB_SSD1325Z2_MOCK_H
+
+/*
+ * Stand-ins of the bus engines, for tests on host without libohiboard.
+ * They only depend on the standard headers, and their functions have the
+ * same prototype of the engine functions, so they can be used as:
+ *
+ *     static const SSD1325Z2_I2cEngine engine = { SSD1325Z2_MockI2c_write };
+ *     dev.i2cEngine = &engine;
+ *     dev.i2cContext = &mock;
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Loopback I2C engine: it counts the transactions and the bytes, and saves
+ * the stream received by the device into an optional capture buffer.
+ */
+typedef struct _SSD1325Z2_MockI2c
+{
+    uint32_t transactions;                 /**< Number of transactions */
+    uint32_t busBytes;  /**< Bytes on the bus, with address and control byte */
+    uint32_t commandBytes;                  /**< Received command bytes */
+    uint32_t dataBytes;                        /**< Received data bytes */
+    uint16_t longestTransaction;      /**< Longest payload into a transaction */
+    uint8_t lastAddress;              /**< Address of the last transaction */
+
+    uint8_t* capture;          /**< Buffer for the received bytes, or NULL */
+    uint32_t captureSize;                   /**< Dimension of the buffer */
+    uint32_t captureLength;                /**< Number of saved bytes */
+} SSD1325Z2_MockI2c;
+
+/**
+ * The function clears the counters and the capture of the mock.
+ *
+ * @param[in] mock The mock to reset
+ */
+void SSD1325Z2_MockI2c_reset (SSD1325Z2_MockI2c* mock);
+
+/**
+ * The write function of the engine: context must point to the mock.
+ */
+void SSD1325Z2_MockI2c_write (void* context,
+                              uint8_t address,
+                              uint8_t control,
+                              const uint8_t* data,
+                              uint16_t length);
+
+#endif /* __WARCOMEB_SSD1325Z2_MOCK_H */
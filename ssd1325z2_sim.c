@@ -0,0 +1,333 @@
+/******************************************************************************
+ * SSD1325Z2 - Library for SSD1325Z2 OLed Driver based on libohiboard
+ * Copyright (C) 2018 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include "ssd1325z2_sim.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define SSD1325Z2_SIM_REMAP_COLUMN               0x01
+#define SSD1325Z2_SIM_REMAP_NIBBLE               0x02
+#define SSD1325Z2_SIM_REMAP_ADDR_INCREMENT       0x04
+#define SSD1325Z2_SIM_REMAP_COM                  0x10
+
+#define SSD1325Z2_SIM_I2C_CONTROL_DATA           0x40
+
+/**
+ * The function returns the number of arguments of a command.
+ */
+static uint8_t SSD1325Z2_Sim_argumentLength (uint8_t command)
+{
+    switch (command)
+    {
+    case 0x15: // Set column address
+    case 0x75: // Set row address
+        return 2;
+    case 0x24: // Draw rectangle
+        return 5;
+    case 0x25: // Copy
+        return 6;
+    case 0x26: // Horizontal scroll
+        return 4;
+    case 0xB8: // Gray scale table
+        return 8;
+    case 0x23: // Graphic acceleration options
+    case 0x81: // Contrast
+    case 0xA0: // Re-map
+    case 0xA1: // Start line
+    case 0xA2: // Display offset
+    case 0xA8: // Multiplex ratio
+    case 0xAD: // Master configuration
+    case 0xB0: // Pre-charge compensation enable
+    case 0xB1: // Phase length
+    case 0xB2: // Row period
+    case 0xB3: // Display clock
+    case 0xB4: // Pre-charge compensation level
+    case 0xBC: // Pre-charge voltage
+    case 0xBE: // VCOMH voltage
+    case 0xBF: // VSL voltage
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * The function applies a command with all its arguments.
+ */
+static void SSD1325Z2_Sim_drawRectangle (SSD1325Z2_Sim* sim, const uint8_t* args)
+{
+    uint8_t columnStart = args[0] % SSD1325Z2_SIM_COLUMNS;
+    uint8_t rowStart = args[1] % SSD1325Z2_SIM_ROWS;
+    uint8_t columnStop = args[2] % SSD1325Z2_SIM_COLUMNS;
+    uint8_t rowStop = args[3] % SSD1325Z2_SIM_ROWS;
+
+    for (uint8_t row = rowStart; row <= rowStop; row++)
+    {
+        for (uint8_t column = columnStart; column <= columnStop; column++)
+        {
+            // Without fill only the outline is drawn
+            if ((sim->acceleration & 0x01) ||
+                (row == rowStart) || (row == rowStop) ||
+                (column == columnStart) || (column == columnStop))
+                sim->gddram[row][column] = args[4];
+        }
+    }
+}
+
+static void SSD1325Z2_Sim_copy (SSD1325Z2_Sim* sim, const uint8_t* args)
+{
+    uint8_t columnStart = args[0] % SSD1325Z2_SIM_COLUMNS;
+    uint8_t rowStart = args[1] % SSD1325Z2_SIM_ROWS;
+    uint8_t columnStop = args[2] % SSD1325Z2_SIM_COLUMNS;
+    uint8_t rowStop = args[3] % SSD1325Z2_SIM_ROWS;
+    uint8_t columnDest = args[4] % SSD1325Z2_SIM_COLUMNS;
+    uint8_t rowDest = args[5] % SSD1325Z2_SIM_ROWS;
+
+    if ((columnStop < columnStart) || (rowStop < rowStart)) return;
+
+    uint8_t rows = rowStop - rowStart + 1;
+    uint8_t columns = columnStop - columnStart + 1;
+    if (rowDest + rows > SSD1325Z2_SIM_ROWS) rows = SSD1325Z2_SIM_ROWS - rowDest;
+    if (columnDest + columns > SSD1325Z2_SIM_COLUMNS) columns = SSD1325Z2_SIM_COLUMNS - columnDest;
+
+    // Like memmove, every byte is read before the copy writes over it, so
+    // overlap is allowed: the copy starts from the side of the destination
+    bool isDown = (rowDest > rowStart);
+    bool isRight = (columnDest > columnStart);
+    for (uint8_t i = 0; i < rows; i++)
+    {
+        uint8_t row = isDown ? (rows - 1 - i) : i;
+        for (uint8_t j = 0; j < columns; j++)
+        {
+            uint8_t column = isRight ? (columns - 1 - j) : j;
+            sim->gddram[rowDest + row][columnDest + column] =
+                sim->gddram[rowStart + row][columnStart + column];
+        }
+    }
+}
+
+static void SSD1325Z2_Sim_execute (SSD1325Z2_Sim* sim)
+{
+    const uint8_t* args = sim->arguments;
+
+    switch (sim->command)
+    {
+    case 0x23:
+        sim->acceleration = args[0];
+        break;
+    case 0x24:
+        SSD1325Z2_Sim_drawRectangle(sim,args);
+        break;
+    case 0x25:
+        SSD1325Z2_Sim_copy(sim,args);
+        break;
+    case 0x15:
+        sim->columnStart = args[0] % SSD1325Z2_SIM_COLUMNS;
+        sim->columnStop = args[1] % SSD1325Z2_SIM_COLUMNS;
+        sim->column = sim->columnStart;
+        break;
+    case 0x75:
+        sim->rowStart = args[0] % SSD1325Z2_SIM_ROWS;
+        sim->rowStop = args[1] % SSD1325Z2_SIM_ROWS;
+        sim->row = sim->rowStart;
+        break;
+    case 0x81:
+        sim->contrast = args[0] & 0x7F;
+        break;
+    case 0xB8:
+        memcpy(sim->grayTable,args,sizeof(sim->grayTable));
+        break;
+    case 0xA0:
+        sim->remap = args[0];
+        break;
+    case 0xA1:
+        sim->startLine = args[0] % SSD1325Z2_SIM_ROWS;
+        break;
+    case 0xA2:
+        sim->offset = args[0] % SSD1325Z2_SIM_ROWS;
+        break;
+    case 0xA4:
+    case 0xA5:
+    case 0xA6:
+    case 0xA7:
+        sim->mode = sim->command;
+        break;
+    case 0xAE:
+        sim->isOn = false;
+        break;
+    case 0xAF:
+        sim->isOn = true;
+        break;
+    }
+}
+
+static void SSD1325Z2_Sim_command (SSD1325Z2_Sim* sim, uint8_t value)
+{
+    sim->commandBytes++;
+
+    if (sim->argumentCount < sim->argumentLength)
+    {
+        sim->arguments[sim->argumentCount++] = value;
+    }
+    else
+    {
+        sim->commands++;
+        sim->command = value;
+        sim->argumentCount = 0;
+        sim->argumentLength = SSD1325Z2_Sim_argumentLength(value);
+    }
+
+    if (sim->argumentCount == sim->argumentLength)
+        SSD1325Z2_Sim_execute(sim);
+}
+
+static void SSD1325Z2_Sim_data (SSD1325Z2_Sim* sim, uint8_t value)
+{
+    sim->dataBytes++;
+    sim->gddram[sim->row][sim->column] = value;
+
+    if (sim->remap & SSD1325Z2_SIM_REMAP_ADDR_INCREMENT)
+    {
+        if (sim->row++ >= sim->rowStop)
+        {
+            sim->row = sim->rowStart;
+            if (sim->column++ >= sim->columnStop) sim->column = sim->columnStart;
+        }
+    }
+    else
+    {
+        if (sim->column++ >= sim->columnStop)
+        {
+            sim->column = sim->columnStart;
+            if (sim->row++ >= sim->rowStop) sim->row = sim->rowStart;
+        }
+    }
+}
+
+void SSD1325Z2_Sim_init (SSD1325Z2_Sim* sim, uint8_t width, uint8_t height)
+{
+    memset(sim,0,sizeof(SSD1325Z2_Sim));
+
+    sim->width = width;
+    sim->height = height;
+    sim->columnStop = SSD1325Z2_SIM_COLUMNS - 1;
+    sim->rowStop = SSD1325Z2_SIM_ROWS - 1;
+    sim->contrast = 0x40;
+    sim->mode = 0xA4;
+}
+
+void SSD1325Z2_Sim_resetCounters (SSD1325Z2_Sim* sim)
+{
+    sim->commands = 0;
+    sim->commandBytes = 0;
+    sim->dataBytes = 0;
+    sim->transactions = 0;
+}
+
+void SSD1325Z2_Sim_writeCommand (void* bus, uint8_t command)
+{
+    SSD1325Z2_Sim* sim = (SSD1325Z2_Sim*)bus;
+
+    sim->transactions++;
+    SSD1325Z2_Sim_command(sim,command);
+}
+
+void SSD1325Z2_Sim_writeCommandBlock (void* bus, const uint8_t* commands, uint16_t length)
+{
+    SSD1325Z2_Sim* sim = (SSD1325Z2_Sim*)bus;
+
+    sim->transactions++;
+    for (uint16_t i = 0; i < length; i++)
+        SSD1325Z2_Sim_command(sim,commands[i]);
+}
+
+void SSD1325Z2_Sim_writeData (void* bus, uint8_t value)
+{
+    SSD1325Z2_Sim* sim = (SSD1325Z2_Sim*)bus;
+
+    sim->transactions++;
+    SSD1325Z2_Sim_data(sim,value);
+}
+
+void SSD1325Z2_Sim_writeDataBlock (void* bus, const uint8_t* data, uint16_t length)
+{
+    SSD1325Z2_Sim* sim = (SSD1325Z2_Sim*)bus;
+
+    sim->transactions++;
+    for (uint16_t i = 0; i < length; i++)
+        SSD1325Z2_Sim_data(sim,data[i]);
+}
+
+void SSD1325Z2_Sim_i2cWrite (void* context,
+                             uint8_t address,
+                             uint8_t control,
+                             const uint8_t* data,
+                             uint16_t length)
+{
+    (void)address;
+
+    if (control & SSD1325Z2_SIM_I2C_CONTROL_DATA)
+        SSD1325Z2_Sim_writeDataBlock(context,data,length);
+    else
+        SSD1325Z2_Sim_writeCommandBlock(context,data,length);
+}
+
+uint8_t SSD1325Z2_Sim_getPixel (const SSD1325Z2_Sim* sim, uint8_t xPos, uint8_t yPos)
+{
+    if (!sim->isOn || (sim->mode == 0xA6)) return 0;
+    if (sim->mode == 0xA5) return 15;
+
+    // The column re-map mirrors the whole RAM, wider than the panel
+    if (sim->remap & SSD1325Z2_SIM_REMAP_COLUMN) xPos = SSD1325Z2_SIM_COLUMNS*2 - 1 - xPos;
+    if (sim->remap & SSD1325Z2_SIM_REMAP_COM) yPos = sim->height - 1 - yPos;
+
+    uint8_t row = (yPos + sim->startLine + sim->offset) % SSD1325Z2_SIM_ROWS;
+    uint8_t value = sim->gddram[row][xPos/2];
+
+    // Without nibble re-map the left pixel is the low nibble
+    bool isHigh = ((xPos % 2) == 0) == ((sim->remap & SSD1325Z2_SIM_REMAP_NIBBLE) != 0);
+    uint8_t level = isHigh ? (value >> 4) : (value & 0x0F);
+
+    return (sim->mode == 0xA7) ? (15 - level) : level;
+}
+
+bool SSD1325Z2_Sim_savePgm (const SSD1325Z2_Sim* sim, const char* path)
+{
+    FILE* file = fopen(path,"wb");
+    if (file == NULL) return false;
+
+    fprintf(file,"P5\n%u %u\n15\n",sim->width,sim->height);
+    for (uint8_t y = 0; y < sim->height; y++)
+    {
+        for (uint8_t x = 0; x < sim->width; x++)
+            fputc(SSD1325Z2_Sim_getPixel(sim,x,y),file);
+    }
+
+    bool isDone = (ferror(file) == 0);
+    return (fclose(file) == 0) && isDone;
+}
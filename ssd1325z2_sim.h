@@ -0,0 +1,144 @@
+/******************************************************************************
+ * SSD1325Z2 - Library for SSD1325Z2 OLed Driver based on libohiboard
+ * Copyright (C) 2018 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef __WARCOMEB_SSD1325Z2_SIM_H
+#define __WARCOMEB_SSD1325Z2_SIM_H
+
+/*
+ * Virtual SSD1325 controller, for tests and measures on host without
+ * libohiboard. It parses the command stream, keeps the display RAM and
+ * counts the traffic. Its functions have the same prototype of the bus
+ * operations, so it can be used as:
+ *
+ *     static const SSD1325Z2_BusOps ops =
+ *     {
+ *         .writeCommand        = SSD1325Z2_Sim_writeCommand,
+ *         .writeCommandBlock   = SSD1325Z2_Sim_writeCommandBlock,
+ *         .writeData           = SSD1325Z2_Sim_writeData,
+ *         .writeDataBlock      = SSD1325Z2_Sim_writeDataBlock,
+ *         .writeDataBlockAsync = NULL,
+ *     };
+ *     SSD1325Z2_initStart(&dev,&ops,&sim,0);
+ *
+ * or, with the I2C interface, as write function of the I2C engine.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SSD1325Z2_SIM_COLUMNS                    64 /**< Columns of the RAM, two pixels each */
+#define SSD1325Z2_SIM_ROWS                       80 /**< Rows of the RAM */
+
+typedef struct _SSD1325Z2_Sim
+{
+    /** Display RAM, every byte holds two pixels */
+    uint8_t gddram [SSD1325Z2_SIM_ROWS][SSD1325Z2_SIM_COLUMNS];
+
+    uint8_t width;                           /**< Width of the panel */
+    uint8_t height;                         /**< Height of the panel */
+
+    uint8_t columnStart;                 /**< Window set with 0x15 command */
+    uint8_t columnStop;
+    uint8_t rowStart;                    /**< Window set with 0x75 command */
+    uint8_t rowStop;
+    uint8_t column;                          /**< Current write address */
+    uint8_t row;
+
+    uint8_t remap;                                /**< Re-map settings */
+    uint8_t startLine;                            /**< Display start line */
+    uint8_t offset;                                /**< Display offset */
+    uint8_t contrast;                               /**< Current contrast */
+    uint8_t mode;               /**< Display mode, from 0xA4 to 0xA7 command */
+    uint8_t acceleration;      /**< Graphic acceleration options, 0x23 command */
+    uint8_t grayTable [8];              /**< Gray scale table, 0xB8 command */
+    bool isOn;                        /**< TRUE after display on command */
+
+    uint8_t command;                  /**< Command waiting its arguments */
+    uint8_t arguments [8];
+    uint8_t argumentCount;                  /**< Arguments received */
+    uint8_t argumentLength;                 /**< Arguments expected */
+
+    uint32_t commands;                        /**< Number of commands */
+    uint32_t commandBytes;    /**< Bytes of commands, with their arguments */
+    uint32_t dataBytes;                            /**< Bytes of data */
+    uint32_t transactions;   /**< Transfers, each one a chip-select cycle */
+} SSD1325Z2_Sim;
+
+/**
+ * The function resets the controller state and clears the counters.
+ *
+ * @param[in] sim The simulator
+ * @param[in] width The width of the panel, in pixels
+ * @param[in] height The height of the panel, in pixels
+ */
+void SSD1325Z2_Sim_init (SSD1325Z2_Sim* sim, uint8_t width, uint8_t height);
+
+/**
+ * The function clears the counters of the traffic.
+ *
+ * @param[in] sim The simulator
+ */
+void SSD1325Z2_Sim_resetCounters (SSD1325Z2_Sim* sim);
+
+/**
+ * Bus operations: bus must point to the simulator.
+ */
+void SSD1325Z2_Sim_writeCommand (void* bus, uint8_t command);
+void SSD1325Z2_Sim_writeCommandBlock (void* bus, const uint8_t* commands, uint16_t length);
+void SSD1325Z2_Sim_writeData (void* bus, uint8_t value);
+void SSD1325Z2_Sim_writeDataBlock (void* bus, const uint8_t* data, uint16_t length);
+
+/**
+ * Write function of the I2C engine: context must point to the simulator.
+ */
+void SSD1325Z2_Sim_i2cWrite (void* context,
+                             uint8_t address,
+                             uint8_t control,
+                             const uint8_t* data,
+                             uint16_t length);
+
+/**
+ * The function returns the gray level shown by a pixel of the panel, with
+ * display mode, start line, offset and re-map applied.
+ *
+ * @param[in] sim The simulator
+ * @param[in] xPos The x position on the panel
+ * @param[in] yPos The y position on the panel
+ * @return The gray level, from 0 to 15
+ */
+uint8_t SSD1325Z2_Sim_getPixel (const SSD1325Z2_Sim* sim, uint8_t xPos, uint8_t yPos);
+
+/**
+ * The function saves the image shown by the panel as binary PGM file.
+ *
+ * @param[in] sim The simulator
+ * @param[in] path The name of the file
+ * @return FALSE if the file can not be written, TRUE otherwise.
+ */
+bool SSD1325Z2_Sim_savePgm (const SSD1325Z2_Sim* sim, const char* path);
+
+#endif /* __WARCOMEB_SSD1325Z2_SIM_H */
@@ -0,0 +1,310 @@
+/******************************************************************************
+ * SSD1325Z2 - Library for SSD1325Z2 OLed Driver based on libohiboard
+ * Copyright (C) 2018 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+/*
+ * Test of the compositor on host, with the virtual controller of
+ * ssd1325z2_sim.c: sprites with and without transparent color, at odd
+ * positions and partly outside of the display, are moved, shown, hidden and
+ * changed, and after every compose the panel is compared with an image of
+ * the scene drawn pixel by pixel by the test. It prints the failed checks
+ * and returns the number of failures.
+ *
+ * It needs the GDL sources and the libohiboard headers, for example:
+ *
+ *     cc -std=gnu99 -D__NO_BOARD_H \
+ *        -DWARCOMEB_SSD1325Z2_WIDTH=128 -DWARCOMEB_SSD1325Z2_HEIGHT=64 \
+ *        -I. -I<libohiboard>/includes -I<path of GDL> \
+ *        test/ssd1325z2_compositor_test.c ssd1325z2.c ssd1325z2_compositor.c \
+ *        ssd1325z2_sim.c <GDL>/gdl.c -o ssd1325z2_compositor_test
+ *
+ * No transport must be selected (WARCOMEB_GDL_PARALLEL, _I2C or _SPI).
+ */
+
+#include "ssd1325z2.h"
+#include "ssd1325z2_compositor.h"
+#include "ssd1325z2_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SSD1325Z2_TEST_ROUNDS                    200
+#define SSD1325Z2_TEST_SPRITE_WIDTH              40
+#define SSD1325Z2_TEST_SPRITE_HEIGHT             30
+#define SSD1325Z2_TEST_SPRITE_BYTES              (SSD1325Z2_TEST_SPRITE_WIDTH / 2 * SSD1325Z2_TEST_SPRITE_HEIGHT)
+
+#define SSD1325Z2_TEST_CHECK(condition) do {                                \
+    if (!(condition))                                                       \
+    {                                                                       \
+        printf("%s:%d: check failed: %s\n",__FILE__,__LINE__,#condition);   \
+        failures++;                                                         \
+    }                                                                       \
+    } while (0)
+
+static const SSD1325Z2_BusOps SSD1325Z2_testBusOps =
+{
+    .writeCommand        = SSD1325Z2_Sim_writeCommand,
+    .writeCommandBlock   = SSD1325Z2_Sim_writeCommandBlock,
+    .writeData           = SSD1325Z2_Sim_writeData,
+    .writeDataBlock      = SSD1325Z2_Sim_writeDataBlock,
+    .writeDataBlockAsync = NULL,
+};
+
+static SSD1325Z2_Device dev;
+static SSD1325Z2_Sim sim;
+static SSD1325Z2_Compositor compositor;
+static int failures;
+
+/* The background, with the layout of the buffer */
+static uint8_t background [WARCOMEB_SSD1325Z2_WIDTH * WARCOMEB_SSD1325Z2_HEIGHT / 2];
+/* Two pictures for every sprite, to change it */
+static uint8_t pictures [WARCOMEB_SSD1325Z2_COMPOSITOR_SPRITES][2][SSD1325Z2_TEST_SPRITE_BYTES];
+
+static void SSD1325Z2_Test_delay (uint32_t delay)
+{
+    (void)delay;
+}
+
+static uint8_t SSD1325Z2_Test_nibble (const uint8_t* data, uint8_t stride, uint8_t xPos, uint8_t yPos)
+{
+    uint8_t value = data[(yPos * stride) + (xPos / 2)];
+    return (xPos % 2) ? (value & 0x0F) : (value >> 4);
+}
+
+/*
+ * The function draws the scene pixel by pixel, the sprites from the lowest
+ * z and in the order they were added with the same z, and compares it with
+ * the panel.
+ */
+static void SSD1325Z2_Test_compare (const char* step)
+{
+    static uint8_t image [WARCOMEB_SSD1325Z2_HEIGHT][WARCOMEB_SSD1325Z2_WIDTH];
+    bool isDrawn [WARCOMEB_SSD1325Z2_COMPOSITOR_SPRITES] = {FALSE};
+    uint16_t differences = 0;
+
+    for (uint8_t y = 0; y < dev.gdl.height; y++)
+    {
+        for (uint8_t x = 0; x < dev.gdl.width; x++)
+        {
+            image[y][x] = (compositor.background != NULL) ?
+                          SSD1325Z2_Test_nibble(background,dev.gdl.width / 2,x,y) :
+                          compositor.backgroundColor;
+        }
+    }
+
+    for (uint8_t i = 0; i < compositor.spriteCount; i++)
+    {
+        // The lowest sprite not yet drawn
+        uint8_t lowest = 0xFF;
+        for (uint8_t j = 0; j < compositor.spriteCount; j++)
+        {
+            if (!isDrawn[j] && ((lowest == 0xFF) || (compositor.sprites[j].z < compositor.sprites[lowest].z)))
+                lowest = j;
+        }
+        isDrawn[lowest] = TRUE;
+
+        const SSD1325Z2_Sprite* sprite = &compositor.sprites[lowest];
+        if (!sprite->isVisible) continue;
+
+        for (uint8_t y = 0; y < sprite->height; y++)
+        {
+            for (uint8_t x = 0; x < sprite->width; x++)
+            {
+                int16_t xPos = sprite->xPos + x;
+                int16_t yPos = sprite->yPos + y;
+                uint8_t pixel = SSD1325Z2_Test_nibble(sprite->picture,(sprite->width + 1) / 2,x,y);
+
+                if ((xPos >= 0) && (xPos < dev.gdl.width) && (yPos >= 0) && (yPos < dev.gdl.height) &&
+                    (pixel != sprite->key))
+                    image[yPos][xPos] = pixel;
+            }
+        }
+    }
+
+    for (uint8_t y = 0; y < dev.gdl.height; y++)
+    {
+        for (uint8_t x = 0; x < dev.gdl.width; x++)
+        {
+            if (SSD1325Z2_Sim_getPixel(&sim,x,y) != image[y][x])
+                differences++;
+        }
+    }
+
+    if (differences > 0)
+    {
+        printf("%s: %u pixels differ\n",step,differences);
+        failures++;
+    }
+}
+
+/*
+ * The damaged areas never overlap, so no pixel is composed twice, and they
+ * are into the display.
+ */
+static void SSD1325Z2_Test_checkDamage (void)
+{
+    for (uint8_t i = 0; i < compositor.damageCount; i++)
+    {
+        const SSD1325Z2_Rect* rect = &compositor.damage[i];
+        SSD1325Z2_TEST_CHECK((rect->xStart <= rect->xStop) && (rect->xStop < dev.gdl.width) &&
+                             (rect->yStart <= rect->yStop) && (rect->yStop < dev.gdl.height));
+
+        for (uint8_t j = i + 1; j < compositor.damageCount; j++)
+        {
+            const SSD1325Z2_Rect* other = &compositor.damage[j];
+            SSD1325Z2_TEST_CHECK((rect->xStart > other->xStop) || (rect->xStop < other->xStart) ||
+                                 (rect->yStart > other->yStop) || (rect->yStop < other->yStart));
+        }
+    }
+}
+
+static int16_t SSD1325Z2_Test_position (uint8_t size, uint8_t displaySize)
+{
+    // From completely outside on a side to completely outside on the other
+    return (int16_t)(rand() % (displaySize + 2 * size + 8)) - size - 4;
+}
+
+static void SSD1325Z2_Test_compositor (const uint8_t* picture, SSD1325Z2_GrayScale color)
+{
+    SSD1325Z2_Sprite* sprites [WARCOMEB_SSD1325Z2_COMPOSITOR_SPRITES];
+    uint8_t current [WARCOMEB_SSD1325Z2_COMPOSITOR_SPRITES] = {0};
+    bool isFull = FALSE;
+
+    SSD1325Z2_Compositor_init(&compositor,&dev,picture,color);
+
+    for (uint8_t i = 0; i < WARCOMEB_SSD1325Z2_COMPOSITOR_SPRITES; i++)
+    {
+        // Odd sizes too, a few z for the sprites with the same z, and half
+        // of them with a transparent color
+        uint8_t width = 1 + rand() % SSD1325Z2_TEST_SPRITE_WIDTH;
+        uint8_t height = 1 + rand() % SSD1325Z2_TEST_SPRITE_HEIGHT;
+        uint8_t key = (rand() % 2) ? (uint8_t)(rand() % 16) : SSD1325Z2_COMPOSITOR_OPAQUE;
+
+        sprites[i] = SSD1325Z2_Compositor_add(&compositor,pictures[i][0],width,height,rand() % 4,key);
+        SSD1325Z2_TEST_CHECK(sprites[i] != NULL);
+        SSD1325Z2_Compositor_move(&compositor,sprites[i],
+                                  SSD1325Z2_Test_position(width,dev.gdl.width),
+                                  SSD1325Z2_Test_position(height,dev.gdl.height));
+    }
+    SSD1325Z2_TEST_CHECK(SSD1325Z2_Compositor_add(&compositor,pictures[0][0],1,1,0,0) == NULL);
+
+    SSD1325Z2_Compositor_compose(&compositor);
+    SSD1325Z2_Test_compare("first compose");
+
+    for (uint16_t round = 0; round < SSD1325Z2_TEST_ROUNDS; round++)
+    {
+        for (uint8_t i = 0; i < WARCOMEB_SSD1325Z2_COMPOSITOR_SPRITES; i++)
+        {
+            SSD1325Z2_Sprite* sprite = sprites[i];
+
+            switch (rand() % 6)
+            {
+            case 0:
+            case 1:
+            case 2:
+                SSD1325Z2_Compositor_move(&compositor,sprite,
+                                          SSD1325Z2_Test_position(sprite->width,dev.gdl.width),
+                                          SSD1325Z2_Test_position(sprite->height,dev.gdl.height));
+                break;
+            case 3:
+                // A small step, often to an odd position
+                SSD1325Z2_Compositor_move(&compositor,sprite,
+                                          sprite->xPos + (rand() % 5) - 2,sprite->yPos + (rand() % 5) - 2);
+                break;
+            case 4:
+                SSD1325Z2_Compositor_show(&compositor,sprite,!sprite->isVisible);
+                break;
+            default:
+                current[i] = !current[i];
+                SSD1325Z2_Compositor_setPicture(&compositor,sprite,pictures[i][current[i]]);
+                break;
+            }
+            SSD1325Z2_Test_checkDamage();
+        }
+
+        // Small areas apart, often more than the table holds, merged with
+        // the areas that grow less
+        for (uint8_t i = 0; i < 2 * WARCOMEB_SSD1325Z2_COMPOSITOR_DAMAGE; i++)
+        {
+            if (rand() % 2) continue;
+
+            if (compositor.damageCount == WARCOMEB_SSD1325Z2_COMPOSITOR_DAMAGE)
+                isFull = TRUE;
+            SSD1325Z2_Compositor_damage(&compositor,SSD1325Z2_Test_position(3,dev.gdl.width),
+                                        SSD1325Z2_Test_position(3,dev.gdl.height),1 + rand() % 3,1 + rand() % 3);
+            SSD1325Z2_Test_checkDamage();
+        }
+
+        if ((picture != NULL) && (rand() % 4 == 0))
+        {
+            // A change of the background
+            uint8_t x = rand() % dev.gdl.width;
+            uint8_t y = rand() % dev.gdl.height;
+            uint8_t width = 1 + rand() % (dev.gdl.width - x);
+            uint8_t height = 1 + rand() % (dev.gdl.height - y);
+            for (uint8_t row = y; row < y + height; row++)
+            {
+                for (uint8_t column = x / 2; column <= (x + width - 1) / 2; column++)
+                    background[(row * (dev.gdl.width / 2)) + column] = rand();
+            }
+            SSD1325Z2_Compositor_damage(&compositor,x & ~1,y,((x + width + 1) & ~1) - (x & ~1),height);
+        }
+
+        SSD1325Z2_Compositor_compose(&compositor);
+        SSD1325Z2_TEST_CHECK(compositor.damageCount == 0);
+        SSD1325Z2_Test_compare("compose");
+    }
+
+    // Some areas were added with the table full
+    SSD1325Z2_TEST_CHECK(isFull);
+}
+
+int main (void)
+{
+    srand(1325);
+    for (uint16_t i = 0; i < sizeof(background); i++)
+        background[i] = rand();
+    for (uint8_t i = 0; i < WARCOMEB_SSD1325Z2_COMPOSITOR_SPRITES; i++)
+    {
+        for (uint16_t j = 0; j < SSD1325Z2_TEST_SPRITE_BYTES; j++)
+        {
+            pictures[i][0][j] = rand();
+            pictures[i][1][j] = rand();
+        }
+    }
+
+    SSD1325Z2_Sim_init(&sim,WARCOMEB_SSD1325Z2_WIDTH,WARCOMEB_SSD1325Z2_HEIGHT);
+    dev.gdl.delayTime = SSD1325Z2_Test_delay;
+    dev.gdl.product = SSD1325Z2_PRODUCT_RAYSTAR_REX012864F;
+    SSD1325Z2_initStart(&dev,&SSD1325Z2_testBusOps,&sim,0);
+    SSD1325Z2_initPoll(&dev,WARCOMEB_SSD1325Z2_POWERUP_DELAY);
+
+    SSD1325Z2_Test_compositor(background,SSD1325Z2_GRAYSCALE_0);
+    SSD1325Z2_Test_compositor(NULL,SSD1325Z2_GRAYSCALE_9);
+
+    printf("%s: %d failures\n",(failures == 0) ? "PASS" : "FAIL",failures);
+    return failures;
+}
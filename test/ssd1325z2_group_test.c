@@ -0,0 +1,228 @@
+/******************************************************************************
+ * SSD1325Z2 - Library for SSD1325Z2 OLed Driver based on libohiboard
+ * Copyright (C) 2018 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+/*
+ * Test of a group of displays on host, every one with its virtual controller
+ * of ssd1325z2_sim.c: it checks the order of the jobs sent by the steps,
+ * that the changes without room into the queue are sent later, and that
+ * every panel shows its buffer at the end. It prints the failed checks and
+ * returns the number of failures.
+ *
+ * It needs the GDL sources and the libohiboard headers, for example:
+ *
+ *     cc -std=gnu99 -D__NO_BOARD_H \
+ *        -DWARCOMEB_SSD1325Z2_WIDTH=128 -DWARCOMEB_SSD1325Z2_HEIGHT=64 \
+ *        -I. -I<libohiboard>/includes -I<path of GDL> \
+ *        test/ssd1325z2_group_test.c ssd1325z2.c ssd1325z2_group.c \
+ *        ssd1325z2_sim.c <GDL>/gdl.c -o ssd1325z2_group_test
+ *
+ * No transport must be selected (WARCOMEB_GDL_PARALLEL, _I2C or _SPI).
+ */
+
+#include "ssd1325z2.h"
+#include "ssd1325z2_group.h"
+#include "ssd1325z2_sim.h"
+
+#include <stdio.h>
+
+#define SSD1325Z2_TEST_PANELS                    3
+
+#if (WARCOMEB_SSD1325Z2_GROUP_PANELS < SSD1325Z2_TEST_PANELS)
+#error "The test needs a group of three displays!"
+#endif
+
+#define SSD1325Z2_TEST_CHECK(condition) do {                                \
+    if (!(condition))                                                       \
+    {                                                                       \
+        printf("%s:%d: check failed: %s\n",__FILE__,__LINE__,#condition);   \
+        failures++;                                                         \
+    }                                                                       \
+    } while (0)
+
+static const SSD1325Z2_BusOps SSD1325Z2_testBusOps =
+{
+    .writeCommand        = SSD1325Z2_Sim_writeCommand,
+    .writeCommandBlock   = SSD1325Z2_Sim_writeCommandBlock,
+    .writeData           = SSD1325Z2_Sim_writeData,
+    .writeDataBlock      = SSD1325Z2_Sim_writeDataBlock,
+    .writeDataBlockAsync = NULL,
+};
+
+static SSD1325Z2_Device devs [SSD1325Z2_TEST_PANELS];
+static SSD1325Z2_Sim sims [SSD1325Z2_TEST_PANELS];
+static SSD1325Z2_Group group;
+static int failures;
+
+static void SSD1325Z2_Test_delay (uint32_t delay)
+{
+    (void)delay;
+}
+
+/*
+ * The function compares every panel with the buffer of its display.
+ */
+static void SSD1325Z2_Test_compare (const char* step)
+{
+    for (uint8_t i = 0; i < SSD1325Z2_TEST_PANELS; i++)
+    {
+        SSD1325Z2_DeviceHandle dev = &devs[i];
+        uint16_t differences = 0;
+
+        for (uint8_t y = 0; y < dev->gdl.height; y++)
+        {
+            const uint8_t* row = SSD1325Z2_getRow(dev,y);
+            for (uint8_t x = 0; x < dev->gdl.width; x++)
+            {
+                uint8_t pixel = (x % 2) ? (row[x / 2] & 0x0F) : (row[x / 2] >> 4);
+                if (SSD1325Z2_Sim_getPixel(&sims[i],x,y) != pixel)
+                    differences++;
+            }
+        }
+
+        if (differences > 0)
+        {
+            printf("%s: %u pixels differ on the display %u\n",step,differences,i);
+            failures++;
+        }
+    }
+}
+
+/*
+ * The function makes a step, and returns the display that received data, or
+ * SSD1325Z2_TEST_PANELS when none or more than one did.
+ */
+static uint8_t SSD1325Z2_Test_step (void)
+{
+    uint8_t panel = SSD1325Z2_TEST_PANELS;
+    uint8_t panels = 0;
+
+    for (uint8_t i = 0; i < SSD1325Z2_TEST_PANELS; i++)
+        SSD1325Z2_Sim_resetCounters(&sims[i]);
+
+    SSD1325Z2_Group_step(&group);
+
+    for (uint8_t i = 0; i < SSD1325Z2_TEST_PANELS; i++)
+    {
+        if (sims[i].dataBytes > 0)
+        {
+            panel = i;
+            panels++;
+        }
+    }
+    return (panels == 1) ? panel : SSD1325Z2_TEST_PANELS;
+}
+
+/*
+ * A full update of the first display, queued first, a smaller change of the
+ * third one, and an urgent change of the second one, larger than the one of
+ * the third but smaller than a full update: the urgent job goes first, and
+ * then the shortest one.
+ */
+static void SSD1325Z2_Test_order (void)
+{
+    const uint8_t expected [] = {1, 2, 0};
+    uint8_t current = 0;
+
+    SSD1325Z2_drawRectangle(&devs[0],0,0,devs[0].gdl.width,devs[0].gdl.height,SSD1325Z2_GRAYSCALE_7,TRUE);
+    SSD1325Z2_Group_queue(&group,&devs[0],FALSE);
+    SSD1325Z2_drawRectangle(&devs[2],10,10,8,4,SSD1325Z2_GRAYSCALE_3,TRUE);
+    SSD1325Z2_Group_queue(&group,&devs[2],FALSE);
+    SSD1325Z2_drawRectangle(&devs[1],5,5,100,40,SSD1325Z2_GRAYSCALE_12,TRUE);
+    SSD1325Z2_TEST_CHECK(SSD1325Z2_Group_queue(&group,&devs[1],TRUE) == GDL_ERRORS_OK);
+    SSD1325Z2_TEST_CHECK(group.jobCount == 3);
+
+    // The urgent job needs more steps, and no other job is sent meanwhile
+    while (group.jobCount > 0)
+    {
+        uint8_t panel = SSD1325Z2_Test_step();
+        SSD1325Z2_TEST_CHECK(panel < SSD1325Z2_TEST_PANELS);
+        while ((current < sizeof(expected)) && (expected[current] != panel))
+            current++;
+        SSD1325Z2_TEST_CHECK(current < sizeof(expected));
+    }
+    SSD1325Z2_Test_compare("order");
+
+    // A display not into the group is refused
+    SSD1325Z2_Device other;
+    SSD1325Z2_TEST_CHECK(SSD1325Z2_Group_queue(&group,&other,FALSE) == GDL_ERRORS_WRONG_VALUE);
+}
+
+/*
+ * More dirty areas than the jobs of the queue: the areas of the last display
+ * don't find room and stay into it, and the flush sends them.
+ */
+static void SSD1325Z2_Test_overflow (void)
+{
+    for (uint8_t i = 0; i < SSD1325Z2_TEST_PANELS; i++)
+    {
+        // Areas far from each other, so every one has its dirty rectangle
+        for (uint8_t j = 0; j < WARCOMEB_SSD1325Z2_DIRTY_RECTANGLES; j++)
+        {
+            SSD1325Z2_drawRectangle(&devs[i],1 + j * 24,3 + j * 8 + i,5,3,
+                                    (SSD1325Z2_GrayScale)(1 + i * 4 + j),TRUE);
+        }
+    }
+
+    SSD1325Z2_Group_queue(&group,&devs[0],FALSE);
+    SSD1325Z2_Group_queue(&group,&devs[1],FALSE);
+    SSD1325Z2_Group_queue(&group,&devs[2],FALSE);
+
+    uint16_t dirty = devs[0].dirtyCount + devs[1].dirtyCount + devs[2].dirtyCount;
+    SSD1325Z2_TEST_CHECK(group.jobCount == WARCOMEB_SSD1325Z2_GROUP_JOBS);
+    SSD1325Z2_TEST_CHECK(group.jobCount + dirty == SSD1325Z2_TEST_PANELS * WARCOMEB_SSD1325Z2_DIRTY_RECTANGLES);
+
+    SSD1325Z2_Group_flush(&group);
+    SSD1325Z2_TEST_CHECK(group.jobCount == 0);
+    for (uint8_t i = 0; i < SSD1325Z2_TEST_PANELS; i++)
+        SSD1325Z2_TEST_CHECK(devs[i].dirtyCount == 0);
+    SSD1325Z2_Test_compare("overflow");
+}
+
+int main (void)
+{
+    SSD1325Z2_Group_init(&group);
+
+    for (uint8_t i = 0; i < SSD1325Z2_TEST_PANELS; i++)
+    {
+        SSD1325Z2_Sim_init(&sims[i],WARCOMEB_SSD1325Z2_WIDTH,WARCOMEB_SSD1325Z2_HEIGHT);
+        devs[i].gdl.delayTime = SSD1325Z2_Test_delay;
+        devs[i].gdl.product = SSD1325Z2_PRODUCT_RAYSTAR_REX012864F;
+        SSD1325Z2_initStart(&devs[i],&SSD1325Z2_testBusOps,&sims[i],0);
+        SSD1325Z2_initPoll(&devs[i],WARCOMEB_SSD1325Z2_POWERUP_DELAY);
+        SSD1325Z2_TEST_CHECK(SSD1325Z2_Group_add(&group,&devs[i]) == GDL_ERRORS_OK);
+
+        // The same start on the panel and the buffer
+        SSD1325Z2_clear(&devs[i]);
+        SSD1325Z2_flush(&devs[i]);
+    }
+
+    SSD1325Z2_Test_order();
+    SSD1325Z2_Test_overflow();
+
+    printf("%s: %d failures\n",(failures == 0) ? "PASS" : "FAIL",failures);
+    return failures;
+}
@@ -0,0 +1,182 @@
+/******************************************************************************
+ * SSD1325Z2 - Library for SSD1325Z2 OLed Driver based on libohiboard
+ * Copyright (C) 2018 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+/*
+ * Test of the I2C interface on host, with the loopback engine of
+ * ssd1325z2_mock.c: it checks that the transactions never exceed the
+ * maximum size, that the command sequences are grouped, and that the
+ * window data arrives untouched. It prints the failed checks and returns
+ * the number of failures.
+ *
+ * It needs the GDL sources and the libohiboard headers, for example:
+ *
+ *     cc -std=gnu99 -D__NO_BOARD_H -DWARCOMEB_GDL_I2C \
+ *        -DWARCOMEB_SSD1325Z2_WIDTH=128 -DWARCOMEB_SSD1325Z2_HEIGHT=64 \
+ *        -I. -I<libohiboard>/includes -I<path of GDL> \
+ *        test/ssd1325z2_i2c_test.c ssd1325z2.c ssd1325z2_mock.c <GDL>/gdl.c \
+ *        -o ssd1325z2_i2c_test
+ */
+
+#include "ssd1325z2.h"
+#include "ssd1325z2_mock.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if !defined WARCOMEB_GDL_I2C
+#error "The test needs the I2C interface!"
+#endif
+
+#define SSD1325Z2_TEST_ADDRESS                   0x3C
+#define SSD1325Z2_TEST_SMALL_TRANSACTION         32
+#define SSD1325Z2_TEST_CMD_SETCONTRAST           0x81
+
+#define SSD1325Z2_TEST_CHECK(condition) do {                                \
+    if (!(condition))                                                       \
+    {                                                                       \
+        printf("%s:%d: check failed: %s\n",__FILE__,__LINE__,#condition);   \
+        failures++;                                                         \
+    }                                                                       \
+    } while (0)
+
+static const SSD1325Z2_I2cEngine SSD1325Z2_testEngine =
+{
+    .write = SSD1325Z2_MockI2c_write,
+};
+
+static SSD1325Z2_Device dev;
+static SSD1325Z2_MockI2c mock;
+static uint8_t capture [WARCOMEB_SSD1325Z2_BUFFERDIMENSION + 64];
+static int failures;
+
+static void SSD1325Z2_Test_delay (uint32_t delay)
+{
+    (void)delay;
+}
+
+static void SSD1325Z2_Test_reset (void)
+{
+    SSD1325Z2_MockI2c_reset(&mock);
+    mock.capture = capture;
+    mock.captureSize = sizeof(capture);
+}
+
+/* Number of transactions needed for the bytes with the given limit */
+static uint32_t SSD1325Z2_Test_transactions (uint32_t bytes, uint16_t limit)
+{
+    return (bytes + limit - 1) / limit;
+}
+
+static void SSD1325Z2_Test_init (void)
+{
+    dev.gdl.delayTime = SSD1325Z2_Test_delay;
+    dev.gdl.product = SSD1325Z2_PRODUCT_RAYSTAR_REX012864F;
+    dev.address = SSD1325Z2_TEST_ADDRESS;
+    dev.i2cEngine = &SSD1325Z2_testEngine;
+    dev.i2cContext = &mock;
+
+    SSD1325Z2_Test_reset();
+    SSD1325Z2_initStart(&dev,NULL,NULL,0);
+    // Only the display on
+    SSD1325Z2_TEST_CHECK(mock.transactions == 1);
+    SSD1325Z2_TEST_CHECK(mock.commandBytes == 1);
+
+    SSD1325Z2_Test_reset();
+    SSD1325Z2_initPoll(&dev,WARCOMEB_SSD1325Z2_POWERUP_DELAY);
+    // The whole setup of the product into a single transaction
+    SSD1325Z2_TEST_CHECK(mock.transactions == 1);
+    SSD1325Z2_TEST_CHECK(mock.commandBytes == 5);
+    SSD1325Z2_TEST_CHECK(mock.dataBytes == 0);
+    SSD1325Z2_TEST_CHECK(mock.lastAddress == SSD1325Z2_TEST_ADDRESS);
+    SSD1325Z2_TEST_CHECK(dev.maxTransaction == WARCOMEB_SSD1325Z2_I2C_MAX_TRANSACTION);
+}
+
+static void SSD1325Z2_Test_flush (uint16_t limit)
+{
+    dev.maxTransaction = limit;
+    for (uint16_t i = 0; i < WARCOMEB_SSD1325Z2_BUFFERDIMENSION; i++)
+        dev.buffer[i] = (uint8_t)((i * 31) ^ (i >> 3));
+
+    SSD1325Z2_Test_reset();
+    SSD1325Z2_flush(&dev);
+
+    uint32_t commandTransactions = SSD1325Z2_Test_transactions(mock.commandBytes,limit);
+    uint32_t dataTransactions = SSD1325Z2_Test_transactions(WARCOMEB_SSD1325Z2_BUFFERDIMENSION,limit);
+
+    SSD1325Z2_TEST_CHECK(mock.longestTransaction <= limit);
+    SSD1325Z2_TEST_CHECK(mock.dataBytes == WARCOMEB_SSD1325Z2_BUFFERDIMENSION);
+    // The window selection is one transaction, the data the fewest possible
+    SSD1325Z2_TEST_CHECK(mock.commandBytes <= limit);
+    SSD1325Z2_TEST_CHECK(mock.transactions == commandTransactions + dataTransactions);
+    SSD1325Z2_TEST_CHECK(mock.busBytes == 2 * mock.transactions + mock.commandBytes + mock.dataBytes);
+    // The data follow the window commands, untouched
+    SSD1325Z2_TEST_CHECK(mock.captureLength == mock.commandBytes + mock.dataBytes);
+    SSD1325Z2_TEST_CHECK(memcmp(&capture[mock.commandBytes],dev.buffer,WARCOMEB_SSD1325Z2_BUFFERDIMENSION) == 0);
+}
+
+static void SSD1325Z2_Test_flushPart (uint16_t limit)
+{
+    // A window of 50 bytes for 20 rows, longer than the small limit
+    uint8_t xStart = 20, xStop = 119, yStart = 8, yStop = 27;
+    uint16_t rowBytes = (xStop/2) - (xStart/2) + 1;
+    uint16_t rows = yStop - yStart + 1;
+
+    dev.maxTransaction = limit;
+    SSD1325Z2_Test_reset();
+    SSD1325Z2_flushPart(&dev,xStart,xStop,yStart,yStop);
+
+    SSD1325Z2_TEST_CHECK(mock.longestTransaction <= limit);
+    SSD1325Z2_TEST_CHECK(mock.dataBytes == (uint32_t)rowBytes * rows);
+    // The window selection, then every row of the buffer by itself
+    SSD1325Z2_TEST_CHECK(mock.transactions ==
+                         1 + rows * SSD1325Z2_Test_transactions(rowBytes,limit));
+}
+
+static void SSD1325Z2_Test_contrast (void)
+{
+    dev.maxTransaction = WARCOMEB_SSD1325Z2_I2C_MAX_TRANSACTION;
+    SSD1325Z2_Test_reset();
+    SSD1325Z2_setContrast(&dev,0x40);
+
+    // Command and argument into the same transaction
+    SSD1325Z2_TEST_CHECK(mock.transactions == 1);
+    SSD1325Z2_TEST_CHECK(mock.commandBytes == 2);
+    SSD1325Z2_TEST_CHECK((capture[0] == SSD1325Z2_TEST_CMD_SETCONTRAST) && (capture[1] == 0x40));
+}
+
+int main (void)
+{
+    SSD1325Z2_Test_init();
+    SSD1325Z2_Test_flush(WARCOMEB_SSD1325Z2_I2C_MAX_TRANSACTION);
+    SSD1325Z2_Test_flush(SSD1325Z2_TEST_SMALL_TRANSACTION);
+    SSD1325Z2_Test_flushPart(WARCOMEB_SSD1325Z2_I2C_MAX_TRANSACTION);
+    SSD1325Z2_Test_flushPart(SSD1325Z2_TEST_SMALL_TRANSACTION);
+    SSD1325Z2_Test_contrast();
+
+    printf("%s: %d failures\n",(failures == 0) ? "PASS" : "FAIL",failures);
+    return failures;
+}
@@ -0,0 +1,532 @@
+/******************************************************************************
+ * SSD1325Z2 - Library for SSD1325Z2 OLed Driver based on libohiboard
+ * Copyright (C) 2018 Marco Giammarini
+ *
+ * Authors:
+ *  Marco Giammarini <m.giammarini@warcomeb.it>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ ******************************************************************************/
+
+/*
+ * Test of the data sent by the driver, on host: the driver writes to the
+ * virtual controller of ssd1325z2_sim.c, and after every flush the image
+ * shown by the panel is compared with the buffer. It prints the failed
+ * checks and returns the number of failures.
+ *
+ * It needs the GDL sources and the libohiboard headers, for example:
+ *
+ *     cc -std=gnu99 -D__NO_BOARD_H \
+ *        -DWARCOMEB_SSD1325Z2_WIDTH=128 -DWARCOMEB_SSD1325Z2_HEIGHT=64 \
+ *        -I. -I<libohiboard>/includes -I<path of GDL> \
+ *        test/ssd1325z2_sim_test.c ssd1325z2.c ssd1325z2_sim.c <GDL>/gdl.c \
+ *        -o ssd1325z2_sim_test
+ *
+ * The flush functions of the options are tested when the options are
+ * defined too: WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER for flushChanges,
+ * WARCOMEB_SSD1325Z2_USE_ACCELERATION for the accelerated fills, and
+ * WARCOMEB_SSD1325Z2_USE_BANDS for the banded flushes, and
+ * WARCOMEB_SSD1325Z2_USE_DISPLAYLIST for the display list.
+ * No transport must be selected (WARCOMEB_GDL_PARALLEL, _I2C or _SPI).
+ */
+
+#include "ssd1325z2.h"
+#include "ssd1325z2_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SSD1325Z2_TEST_ROUNDS                    200
+
+#define SSD1325Z2_TEST_CHECK(condition) do {                                \
+    if (!(condition))                                                       \
+    {                                                                       \
+        printf("%s:%d: check failed: %s\n",__FILE__,__LINE__,#condition);   \
+        failures++;                                                         \
+    }                                                                       \
+    } while (0)
+
+static const SSD1325Z2_BusOps SSD1325Z2_testBusOps =
+{
+    .writeCommand        = SSD1325Z2_Sim_writeCommand,
+    .writeCommandBlock   = SSD1325Z2_Sim_writeCommandBlock,
+    .writeData           = SSD1325Z2_Sim_writeData,
+    .writeDataBlock      = SSD1325Z2_Sim_writeDataBlock,
+    .writeDataBlockAsync = NULL,
+};
+
+static SSD1325Z2_Device dev;
+static SSD1325Z2_Sim sim;
+static int failures;
+
+/* A 4-bit picture as big as the display */
+static uint8_t picture [WARCOMEB_SSD1325Z2_WIDTH * WARCOMEB_SSD1325Z2_HEIGHT / 2];
+
+static void SSD1325Z2_Test_delay (uint32_t delay)
+{
+    (void)delay;
+}
+
+static void SSD1325Z2_Test_init (SSD1325Z2_DeviceHandle device, SSD1325Z2_Sim* simulator)
+{
+    SSD1325Z2_Sim_init(simulator,WARCOMEB_SSD1325Z2_WIDTH,WARCOMEB_SSD1325Z2_HEIGHT);
+    device->gdl.delayTime = SSD1325Z2_Test_delay;
+    device->gdl.product = SSD1325Z2_PRODUCT_RAYSTAR_REX012864F;
+    SSD1325Z2_initStart(device,&SSD1325Z2_testBusOps,simulator,0);
+    SSD1325Z2_initPoll(device,WARCOMEB_SSD1325Z2_POWERUP_DELAY);
+}
+
+static uint8_t SSD1325Z2_Test_nibble (const uint8_t* data, uint8_t width, uint8_t xPos, uint8_t yPos)
+{
+    uint8_t value = data[(yPos * (width / 2)) + (xPos / 2)];
+    return (xPos % 2) ? (value & 0x0F) : (value >> 4);
+}
+
+/*
+ * The function compares the panel with an image of the display, and counts
+ * a failure when some pixel differs.
+ */
+static void SSD1325Z2_Test_compare (const char* step, const uint8_t* image)
+{
+    uint16_t differences = 0;
+
+    for (uint8_t y = 0; y < dev.gdl.height; y++)
+    {
+        for (uint8_t x = 0; x < dev.gdl.width; x++)
+        {
+            if (SSD1325Z2_Sim_getPixel(&sim,x,y) != SSD1325Z2_Test_nibble(image,dev.gdl.width,x,y))
+                differences++;
+        }
+    }
+
+    if (differences > 0)
+    {
+        printf("%s: %u pixels differ\n",step,differences);
+        failures++;
+    }
+}
+
+/*
+ * The simulator by itself: column re-map on a panel narrower than the RAM,
+ * and copies with overlap.
+ */
+static void SSD1325Z2_Test_simulator (void)
+{
+    SSD1325Z2_Sim narrow;
+    SSD1325Z2_Sim_init(&narrow,96,64);
+
+    // Pixels 32 and 33 of the RAM, the last two of the panel with re-map
+    const uint8_t window[] = {0xAF, 0xA0, 0x01, 0x15, 16, 16, 0x75, 0, 0};
+    SSD1325Z2_Sim_writeCommandBlock(&narrow,window,sizeof(window));
+    SSD1325Z2_Sim_writeData(&narrow,0x5C);
+    SSD1325Z2_TEST_CHECK(SSD1325Z2_Sim_getPixel(&narrow,95,0) == 0x0C);
+    SSD1325Z2_TEST_CHECK(SSD1325Z2_Sim_getPixel(&narrow,94,0) == 0x05);
+
+    // Copy of 10x10 bytes one row down and one column right, and back
+    SSD1325Z2_Sim first, second;
+    SSD1325Z2_Sim_init(&first,128,64);
+    SSD1325Z2_Sim_init(&second,128,64);
+    for (uint8_t row = 0; row < 12; row++)
+    {
+        for (uint8_t column = 0; column < 12; column++)
+        {
+            first.gddram[row][column] = row * 16 + column;
+            second.gddram[row][column] = row * 16 + column;
+        }
+    }
+    const uint8_t forward[] = {0x25, 0, 0, 9, 9, 1, 1};
+    const uint8_t backward[] = {0x25, 1, 1, 10, 10, 0, 0};
+    SSD1325Z2_Sim_writeCommandBlock(&first,forward,sizeof(forward));
+    SSD1325Z2_Sim_writeCommandBlock(&second,forward,sizeof(forward));
+    SSD1325Z2_Sim_writeCommandBlock(&second,backward,sizeof(backward));
+
+    uint16_t wrong = 0;
+    for (uint8_t row = 0; row < 10; row++)
+    {
+        for (uint8_t column = 0; column < 10; column++)
+        {
+            if (first.gddram[row + 1][column + 1] != row * 16 + column) wrong++;
+            if (second.gddram[row][column] != row * 16 + column) wrong++;
+        }
+    }
+    SSD1325Z2_TEST_CHECK(wrong == 0);
+}
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+
+/* The filled rectangle drawn over the picture */
+static SSD1325Z2_Rect rectangle;
+static SSD1325Z2_GrayScale rectangleColor;
+
+static void SSD1325Z2_Test_drawFrame (SSD1325Z2_DeviceHandle device, void* argument)
+{
+    (void)argument;
+    SSD1325Z2_drawPicture(device,0,0,device->gdl.width,device->gdl.height,picture,GDL_PICTURETYPE_4BIT);
+    SSD1325Z2_drawRectangle(device,rectangle.xStart,rectangle.yStart,
+                            rectangle.xStop - rectangle.xStart + 1,rectangle.yStop - rectangle.yStart + 1,
+                            rectangleColor,TRUE);
+}
+
+static void SSD1325Z2_Test_bands (void)
+{
+    static uint8_t image [sizeof(picture)];
+
+    for (uint16_t round = 0; round < SSD1325Z2_TEST_ROUNDS; round++)
+    {
+        rectangle.xStart = rand() % dev.gdl.width;
+        rectangle.xStop = rectangle.xStart + rand() % (dev.gdl.width - rectangle.xStart);
+        rectangle.yStart = rand() % dev.gdl.height;
+        rectangle.yStop = rectangle.yStart + rand() % (dev.gdl.height - rectangle.yStart);
+        rectangleColor = (SSD1325Z2_GrayScale)(rand() % 16);
+        for (uint16_t i = 0; i < sizeof(picture); i++)
+            picture[i] = rand();
+
+        SSD1325Z2_renderBands(&dev,SSD1325Z2_Test_drawFrame,NULL);
+
+        // The image of the frame, drawn by the test
+        for (uint16_t i = 0; i < sizeof(picture); i++)
+            image[i] = picture[i];
+        for (uint8_t y = rectangle.yStart; y <= rectangle.yStop; y++)
+        {
+            for (uint8_t x = rectangle.xStart; x <= rectangle.xStop; x++)
+            {
+                uint8_t* pixel = &image[(y * (dev.gdl.width / 2)) + (x / 2)];
+                *pixel = (x % 2) ? ((*pixel & 0xF0) | rectangleColor) : ((*pixel & 0x0F) | (rectangleColor << 4));
+            }
+        }
+        SSD1325Z2_Test_compare("renderBands",image);
+    }
+}
+
+#else
+
+/*
+ * The function draws something random, all over the display or into an area.
+ */
+static void SSD1325Z2_Test_draw (uint8_t xStart, uint8_t yStart, uint8_t width, uint8_t height)
+{
+    uint8_t count = 1 + rand() % 8;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        uint8_t x = xStart + rand() % width;
+        uint8_t y = yStart + rand() % height;
+        uint8_t w = 1 + rand() % (xStart + width - x);
+        uint8_t h = 1 + rand() % (yStart + height - y);
+        SSD1325Z2_GrayScale color = (SSD1325Z2_GrayScale)(rand() % 16);
+
+        switch (rand() % 3)
+        {
+        case 0:
+            SSD1325Z2_drawRectangle(&dev,x,y,w,h,color,rand() % 2);
+            break;
+        case 1:
+            SSD1325Z2_drawLine(&dev,x,y,x + w - 1,y + h - 1,color);
+            break;
+        default:
+            SSD1325Z2_drawPixel(&dev,x,y,color);
+            break;
+        }
+    }
+}
+
+/*
+ * The rows of the buffer are shown from the top of the panel, in the order of
+ * the ring rotated by the scroll.
+ */
+static void SSD1325Z2_Test_compareBuffer (const char* step)
+{
+    static uint8_t image [WARCOMEB_SSD1325Z2_BUFFERDIMENSION];
+    uint8_t widthHalf = dev.gdl.width/2;
+
+    for (uint8_t y = 0; y < dev.gdl.height; y++)
+        memcpy(&image[y * widthHalf],SSD1325Z2_getRow(&dev,y),widthHalf);
+    SSD1325Z2_Test_compare(step,image);
+}
+
+static void SSD1325Z2_Test_flush (void)
+{
+    SSD1325Z2_drawPicture(&dev,0,0,dev.gdl.width,dev.gdl.height,picture,GDL_PICTURETYPE_4BIT);
+    SSD1325Z2_flush(&dev);
+    SSD1325Z2_Test_compareBuffer("flush");
+
+    for (uint16_t round = 0; round < SSD1325Z2_TEST_ROUNDS; round++)
+    {
+        // Only the changed area is sent
+        uint8_t x = 2 * (rand() % (dev.gdl.width / 2));
+        uint8_t y = rand() % dev.gdl.height;
+        uint8_t width = 2 + 2 * (rand() % ((dev.gdl.width - x) / 2));
+        uint8_t height = 1 + rand() % (dev.gdl.height - y);
+
+        SSD1325Z2_Test_draw(x,y,width,height);
+        SSD1325Z2_flushPart(&dev,x,x + width - 1,y,y + height - 1);
+        SSD1325Z2_Test_compareBuffer("flushPart");
+
+        SSD1325Z2_Test_draw(0,0,dev.gdl.width,dev.gdl.height);
+        SSD1325Z2_flushDirty(&dev);
+        SSD1325Z2_Test_compareBuffer("flushDirty");
+
+#if defined WARCOMEB_SSD1325Z2_USE_SHADOWBUFFER
+        SSD1325Z2_Test_draw(0,0,dev.gdl.width,dev.gdl.height);
+        SSD1325Z2_flushChanges(&dev);
+        SSD1325Z2_Test_compareBuffer("flushChanges");
+#endif
+
+        SSD1325Z2_Test_draw(0,0,dev.gdl.width,dev.gdl.height);
+        SSD1325Z2_flushBegin(&dev);
+        while (!SSD1325Z2_flushStep(&dev,1 + rand() % 300));
+        SSD1325Z2_Test_compareBuffer("flushStep");
+
+        SSD1325Z2_Test_draw(0,0,dev.gdl.width,dev.gdl.height);
+        SSD1325Z2_invertArea(&dev,NULL);
+        SSD1325Z2_flushAsync(&dev,NULL);
+        SSD1325Z2_Test_compareBuffer("flushAsync");
+    }
+}
+
+#if !defined WARCOMEB_SSD1325Z2_USE_FRAMES
+static void SSD1325Z2_Test_scroll (void)
+{
+    // Enough rounds to go around the display RAM many times
+    for (uint16_t round = 0; round < SSD1325Z2_TEST_ROUNDS; round++)
+    {
+        if (rand() % 2)
+        {
+            SSD1325Z2_scrollUp(&dev,rand() % dev.gdl.height,(SSD1325Z2_GrayScale)(rand() % 16));
+            SSD1325Z2_Test_compareBuffer("scrollUp");
+        }
+        else
+        {
+            SSD1325Z2_printLine(&dev,(const uint8_t*)"Line 0123456789",
+                                (SSD1325Z2_GrayScale)(rand() % 16),(SSD1325Z2_GrayScale)(rand() % 16),
+                                1 + rand() % 2);
+            SSD1325Z2_Test_compareBuffer("printLine");
+        }
+
+        // The changes after a scroll are sent with the new start line
+        SSD1325Z2_Test_draw(0,0,dev.gdl.width,dev.gdl.height);
+        SSD1325Z2_flushDirty(&dev);
+        SSD1325Z2_Test_compareBuffer("flushDirty after scroll");
+    }
+}
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_ACCELERATION
+static void SSD1325Z2_Test_acceleration (void)
+{
+    SSD1325Z2_setAcceleration(&dev,TRUE);
+    SSD1325Z2_clear(&dev);
+    SSD1325Z2_Test_compareBuffer("accelerated clear");
+
+    for (uint16_t round = 0; round < SSD1325Z2_TEST_ROUNDS; round++)
+    {
+        SSD1325Z2_Test_draw(0,0,dev.gdl.width,dev.gdl.height);
+        SSD1325Z2_flushDirty(&dev);
+        SSD1325Z2_Test_compareBuffer("accelerated fill");
+
+        uint8_t width = 2 * (1 + rand() % (dev.gdl.width / 4));
+        uint8_t height = 1 + rand() % (dev.gdl.height / 2);
+        SSD1325Z2_moveArea(&dev,2 * (rand() % ((dev.gdl.width - width) / 2 + 1)),rand() % (dev.gdl.height - height + 1),
+                           width,height,
+                           2 * (rand() % ((dev.gdl.width - width) / 2 + 1)),rand() % (dev.gdl.height - height + 1));
+        SSD1325Z2_flushDirty(&dev);
+        SSD1325Z2_Test_compareBuffer("accelerated move");
+    }
+    SSD1325Z2_setAcceleration(&dev,FALSE);
+}
+#endif
+
+#endif
+
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+
+/* The device drawn without the list, as reference */
+static SSD1325Z2_Device reference;
+static SSD1325Z2_Sim referenceSim;
+
+/* The seed and the number of operations of a random mix */
+typedef struct _SSD1325Z2_TestMix
+{
+    unsigned int seed;
+    uint8_t count;
+} SSD1325Z2_TestMix;
+
+/*
+ * The function draws a random mix of the operations that can be recorded,
+ * partly outside of the display: the same seed draws the same mix.
+ */
+static void SSD1325Z2_Test_drawMix (SSD1325Z2_DeviceHandle device, void* argument)
+{
+    const SSD1325Z2_TestMix* mix = (const SSD1325Z2_TestMix*)argument;
+    uint8_t width = device->gdl.width;
+    uint8_t height = device->gdl.height;
+
+    srand(mix->seed);
+    for (uint8_t i = 0; i < mix->count; i++)
+    {
+        uint8_t x = rand() % (width + 8);
+        uint8_t y = rand() % (height + 8);
+        uint8_t w = 1 + rand() % width;
+        uint8_t h = 1 + rand() % height;
+        SSD1325Z2_GrayScale color = (SSD1325Z2_GrayScale)(rand() % 16);
+
+        switch (rand() % 8)
+        {
+        case 0:
+            SSD1325Z2_drawRectangle(device,x,y,w,h,color,rand() % 2);
+            break;
+        case 1:
+            SSD1325Z2_drawRectangle(device,0,y,width,h,color,TRUE);
+            break;
+        case 2:
+            SSD1325Z2_drawLine(device,x,y,rand() % (width + 8),rand() % (height + 8),color);
+            break;
+        case 3:
+            SSD1325Z2_drawHLine(device,x,y,w,color);
+            break;
+        case 4:
+            SSD1325Z2_drawVLine(device,x,y,h,color);
+            break;
+        case 5:
+            SSD1325Z2_drawString(device,x,y,(const uint8_t*)"List 42\nX",color,
+                                 (SSD1325Z2_GrayScale)(rand() % 16),1 + rand() % 2);
+            break;
+        case 6:
+            SSD1325Z2_drawPicture(device,x,y,1 + rand() % 32,1 + rand() % 32,picture,
+                                  (rand() % 2) ? GDL_PICTURETYPE_4BIT : GDL_PICTURETYPE_1BIT);
+            break;
+        default:
+            // A clear now and then, that drops all the operations before
+            if (rand() % 4)
+                break;
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+            // The clear of the bands sends the display by itself
+            if (device == &reference)
+            {
+                SSD1325Z2_drawRectangle(device,0,0,width,height,SSD1325Z2_GRAYSCALE_0,TRUE);
+                break;
+            }
+#endif
+            SSD1325Z2_clear(device);
+            break;
+        }
+    }
+}
+
+/*
+ * The function draws the mix on the reference directly, and on the device
+ * with the list, and compares the two panels.
+ */
+static void SSD1325Z2_Test_drawList (const char* step, uint8_t count)
+{
+    static uint8_t image [sizeof(picture)];
+    SSD1325Z2_TestMix mix = {rand(), count};
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+    SSD1325Z2_renderBands(&reference,SSD1325Z2_Test_drawMix,&mix);
+#else
+    SSD1325Z2_Test_drawMix(&reference,&mix);
+    SSD1325Z2_flushDirty(&reference);
+#endif
+
+    SSD1325Z2_beginList(&dev);
+    SSD1325Z2_Test_drawMix(&dev,&mix);
+    SSD1325Z2_TEST_CHECK(SSD1325Z2_commitList(&dev) == GDL_ERRORS_OK);
+
+    for (uint8_t y = 0; y < dev.gdl.height; y++)
+    {
+        for (uint8_t x = 0; x < dev.gdl.width; x += 2)
+        {
+            image[(y * (dev.gdl.width / 2)) + (x / 2)] = (SSD1325Z2_Sim_getPixel(&referenceSim,x,y) << 4) |
+                                                         SSD1325Z2_Sim_getPixel(&referenceSim,x + 1,y);
+        }
+    }
+    SSD1325Z2_Test_compare(step,image);
+#if !defined WARCOMEB_SSD1325Z2_USE_BANDS
+    SSD1325Z2_Test_compareBuffer(step);
+#endif
+}
+
+static void SSD1325Z2_Test_list (void)
+{
+    SSD1325Z2_Test_init(&reference,&referenceSim);
+    // The same start on both panels
+    SSD1325Z2_clear(&reference);
+    SSD1325Z2_clear(&dev);
+#if !defined WARCOMEB_SSD1325Z2_USE_BANDS
+    SSD1325Z2_flush(&reference);
+    SSD1325Z2_flush(&dev);
+#endif
+
+    // Mixes that fit into the list
+    for (uint16_t round = 0; round < SSD1325Z2_TEST_ROUNDS; round++)
+        SSD1325Z2_Test_drawList("commitList",1 + rand() % 12);
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+    // The operations without room are lost
+    SSD1325Z2_beginList(&dev);
+    for (uint16_t i = 0; i < WARCOMEB_SSD1325Z2_DISPLAYLIST_BYTES; i++)
+        SSD1325Z2_drawRectangle(&dev,i % dev.gdl.width,i % dev.gdl.height,4,4,SSD1325Z2_GRAYSCALE_15,TRUE);
+    SSD1325Z2_TEST_CHECK(SSD1325Z2_commitList(&dev) == GDL_ERRORS_WRONG_VALUE);
+#else
+    // A full list is drawn to make room, and nothing is lost
+    for (uint16_t round = 0; round < SSD1325Z2_TEST_ROUNDS / 10; round++)
+        SSD1325Z2_Test_drawList("commitList of a full list",200);
+#endif
+
+    // The functions that can't be recorded are rejected
+    SSD1325Z2_beginList(&dev);
+    SSD1325Z2_TEST_CHECK(SSD1325Z2_drawPixel(&dev,3,3,SSD1325Z2_GRAYSCALE_5) == GDL_ERRORS_WRONG_VALUE);
+    SSD1325Z2_TEST_CHECK(SSD1325Z2_commitList(&dev) == GDL_ERRORS_WRONG_VALUE);
+}
+
+#endif
+
+int main (void)
+{
+    srand(1325);
+    for (uint16_t i = 0; i < sizeof(picture); i++)
+        picture[i] = rand();
+
+    SSD1325Z2_Test_simulator();
+
+    SSD1325Z2_Test_init(&dev,&sim);
+
+#if defined WARCOMEB_SSD1325Z2_USE_BANDS
+    SSD1325Z2_Test_bands();
+#else
+    SSD1325Z2_Test_flush();
+#if !defined WARCOMEB_SSD1325Z2_USE_FRAMES
+    SSD1325Z2_Test_scroll();
+    // Again, with the rows of the buffer rotated by the scroll
+    SSD1325Z2_Test_flush();
+#endif
+#if defined WARCOMEB_SSD1325Z2_USE_ACCELERATION
+    SSD1325Z2_Test_acceleration();
+#endif
+#endif
+#if defined WARCOMEB_SSD1325Z2_USE_DISPLAYLIST
+    SSD1325Z2_Test_list();
+#endif
+
+    printf("%s: %d failures\n",(failures == 0) ? "PASS" : "FAIL",failures);
+    return failures;
+}